@@ -4,24 +4,35 @@
 
 AI::AI()
 {
+	mPlayer = 2;
+	mEnemy = 1;
 	mTurnNumber = 0;
+	mCooperative = AICOOPERATIVE;
 }
 
-void AI::init()
+void AI::init(U32 player)
 {
-	mAnthill = &GameSingleton::getAIAnthill();
-	mAnthillPlayer = &GameSingleton::getAnthill();
+	ASSERT(player == 1 || player == 2);
+	mPlayer = player;
+	mEnemy = (player == 1) ? 2 : 1;
+	mAnthill = &GameSingleton::getAnthill(mPlayer);
+	mAnthillPlayer = &GameSingleton::getAnthill(mEnemy);
 	mAnthillPos = mAnthill->getCoords();
 	mAnthillPosPlayer = mAnthillPlayer->getCoords();
 }
 
+U32 AI::getPlayer() const
+{
+	return mPlayer;
+}
+
 void AI::startTurn()
 {
 	mCurrentAnt = nullptr;
 	mCurrentAntIndex = 0;
 	mTurnNumber++;
 	mTurnOver = false;
-	mEnemies = GameSingleton::ants;
+	mEnemies = GameSingleton::getAnts(mEnemy);
 
 	if (mTurnNumber == 1)
 	{
@@ -47,6 +58,16 @@ void AI::startTurn()
 			i++;
 		}
 	}
+
+	// Cooperative : the paths of the whole turn are planned now with the known resources, nothing to solve by the workers
+	if (mCooperative)
+	{
+		planTurn();
+	}
+	else
+	{
+		requestTargets();
+	}
 }
 
 void AI::think(oe::Time dt)
@@ -58,22 +79,26 @@ void AI::think(oe::Time dt)
 		tryBuy();
 	}
 
+	if (mCooperative)
+	{
+		playTurn(dt);
+		return;
+	}
+
 	if (mCurrentAnt == nullptr || mCurrentAnt->isTurnOver())
 	{
-		mCurrentAnt = GameSingleton::getAIAnt(mCurrentAntIndex);
+		mCurrentAnt = getAnt(mCurrentAntIndex);
 
 		if (mCurrentAnt != nullptr)
 		{
-			GameSingleton::setCollision(mAnthill->getCoords(), false);
-			if (!AStar::canGo(mCurrentAnt->getCoords(), mAnthill->getCoords(), GameSingleton::collisions))
+			if (!GameSingleton::canReach(mCurrentAnt->getCoords(), mAnthill->getCoords()))
 			{
 				mCurrentAnt = nullptr;
 			}
-			GameSingleton::setCollision(mAnthill->getCoords(), true);
 		}
 
 		mCurrentAntIndex++;
-		if (mCurrentAntIndex > GameSingleton::aiAnts.size())
+		if (mCurrentAntIndex > getAnts().size())
 		{
 			mTurnOver = true;
 		}
@@ -95,11 +120,32 @@ bool AI::isTurnOver() const
 	return mTurnOver;
 }
 
+void AI::setCooperative(bool cooperative)
+{
+	mCooperative = cooperative;
+}
+
+bool AI::isCooperative() const
+{
+	return mCooperative;
+}
+
 void AI::addResource(const oe::Vector2i& coords)
 {
 	mResourcesPos.push_back(coords);
 }
 
+Ant* AI::getAnt(U32 index)
+{
+	oe::EntityList& ants = getAnts();
+	return (index < ants.size()) ? (ants.begin() + index)->getAs<Ant>() : nullptr;
+}
+
+oe::EntityList& AI::getAnts()
+{
+	return GameSingleton::getAnts(mPlayer);
+}
+
 void AI::tryBuy()
 {
 	I32 r = oe::Random::get(0, 2);
@@ -209,13 +255,46 @@ void AI::playSoldier(oe::Time dt)
 
 void AI::goToResource()
 {
-	std::vector<oe::Vector2i> res; // Best res
-	oe::Vector2i coords = mCurrentAnt->getCoords();
+	oe::Vector2i coords;
+	if (findResource(*mCurrentAnt, coords) && coords != mCurrentAnt->getCoords())
+	{
+		mCurrentAnt->goTo(coords);
+	}
+	else
+	{
+		mCurrentAnt->goToAnthill();
+	}
+}
+
+void AI::harass()
+{
+	// The path is being solved, or was requested at the start of the turn, and the target has not moved
+	if (mCurrentAnt->hasTargetPath())
+	{
+		return;
+	}
+
+	// Attacks now when adjacent, the other paths are solved by the workers
+	oe::EntityHandle target = findTarget(*mCurrentAnt);
+	MapEntity* ent = target.getAs<MapEntity>();
+	if (ent != nullptr && mCurrentAnt->isAdjacent(ent->getCoords()))
+	{
+		mCurrentAnt->goToTarget(target);
+	}
+	else
+	{
+		mCurrentAnt->requestTarget(target);
+	}
+}
+
+bool AI::findResource(const Ant& ant, oe::Vector2i& coords)
+{
+	oe::FrameVector<oe::Vector2i> res; // Best res
 	I32 minDistance = 9999;
 	U32 rSize = mResourcesPos.size();
 	for (U32 i = 0; i < rSize; i++)
 	{
-		I32 heur = AStar::heuristic(coords, mResourcesPos[i]);
+		I32 heur = AStar::heuristic(ant.getCoords(), mResourcesPos[i]);
 		bool col = GameSingleton::isCollision(mResourcesPos[i]);
 		if (heur < minDistance && heur >= 0 && !col)
 		{
@@ -231,27 +310,18 @@ void AI::goToResource()
 	if (!res.empty())
 	{
 		U32 index = oe::Random::get(0u, res.size() - 1);
-		if (res[index] != mCurrentAnt->getCoords())
-		{
-			mCurrentAnt->goTo(res[index]);
-		}
-		else
-		{
-			mCurrentAnt->goToAnthill();
-		}
-	}
-	else
-	{
-		mCurrentAnt->goToAnthill();
+		coords = res[index];
+		return true;
 	}
+	return false;
 }
 
-void AI::harass()
+oe::EntityHandle AI::findTarget(const Ant& ant)
 {
 	mEnemies.update();
 
-	std::vector<oe::EntityHandle> res; // Best res
-	oe::Vector2i coords = mCurrentAnt->getCoords();
+	oe::FrameVector<oe::EntityHandle> res; // Best res
+	oe::Vector2i coords = ant.getCoords();
 	I32 minDistance = 9999;
 	Ant* enemy = nullptr;
 	for (auto itr = mEnemies.begin(); itr != mEnemies.end(); ++itr)
@@ -275,10 +345,146 @@ void AI::harass()
 	if (!res.empty())
 	{
 		U32 index = oe::Random::get(0u, res.size() - 1);
-		mCurrentAnt->goToTarget(res[index]);
+		return res[index];
+	}
+	return GameSingleton::getAnthillHandle(mEnemy);
+}
+
+void AI::requestTargets()
+{
+	// All the harass paths of the turn are solved together by the workers
+	for (const oe::EntityHandle& e : getAnts())
+	{
+		Ant* ant = e.getAs<Ant>();
+		if (ant == nullptr || ant->getDestination() != Ant::invalidDest || ant->getResources() > 0)
+		{
+			continue;
+		}
+		if (ant->getType() == Ant::Soldier || (ant->getType() == Ant::Scout && mTurnNumber >= 15))
+		{
+			oe::EntityHandle target = findTarget(*ant);
+			MapEntity* ent = target.getAs<MapEntity>();
+			if (ent != nullptr && !ant->isAdjacent(ent->getCoords()))
+			{
+				ant->requestTarget(target);
+			}
+		}
+	}
+}
+
+void AI::planTurn()
+{
+	// The ants are parked on their cells until they have planned
+	mReservations.create(GameSingleton::collisions.getSize());
+	U32 owner = 0;
+	for (const oe::EntityHandle& e : getAnts())
+	{
+		Ant* ant = e.getAs<Ant>();
+		if (ant != nullptr)
+		{
+			mReservations.addAgent(owner, ant->getCoords());
+		}
+		owner++;
+	}
+	// The ants don't move until the turn is planned : the distances to a goal are shared by the ants going there
+	mCooperativeSearch.newTurn();
+
+	// Each ant avoids the cells reserved by the previous ones, at each step of the turn
+	owner = 0;
+	for (const oe::EntityHandle& e : getAnts())
+	{
+		Ant* ant = e.getAs<Ant>();
+		if (ant != nullptr && ant->canPlay() && GameSingleton::canReach(ant->getCoords(), mAnthillPos))
+		{
+			oe::Vector2i goal;
+			oe::EntityHandle target;
+			bool blockedEnd;
+			chooseGoal(*ant, goal, target, blockedEnd);
+
+			MapEntity* ent = target.getAs<MapEntity>();
+			if (ent != nullptr && ant->isAdjacent(ent->getCoords()))
+			{
+				ant->goToTarget(target);
+			}
+			else
+			{
+				std::list<oe::Vector2i> path;
+				mReservations.release(owner);
+				if (mCooperativeSearch.run(path, ant->getCoords(), goal, GameSingleton::collisions, mReservations, owner, 0, ant->getPM(), blockedEnd))
+				{
+					if (blockedEnd && path.back() == goal)
+					{
+						path.pop_back();
+					}
+					if (path.size() > ant->getPM())
+					{
+						path.resize(ant->getPM());
+					}
+				}
+				mReservations.reservePath(owner, ant->getCoords(), 0, path);
+
+				// The anthill is reached when the ant is next to it
+				oe::Vector2i destination(goal);
+				if (target.isValid() || (blockedEnd && path.empty()))
+				{
+					destination = Ant::invalidDest;
+				}
+				else if (blockedEnd)
+				{
+					destination = path.back();
+				}
+				ant->followPath(path, destination, target);
+			}
+		}
+		owner++;
+	}
+}
+
+void AI::playTurn(oe::Time dt)
+{
+	bool turnOver = true;
+	for (const oe::EntityHandle& e : getAnts())
+	{
+		Ant* ant = e.getAs<Ant>();
+		if (ant != nullptr && (ant->hasPath() || ant->isMoving()))
+		{
+			ant->updateAnt(dt, false);
+			turnOver = false;
+		}
+	}
+	mTurnOver = turnOver;
+}
+
+void AI::chooseGoal(const Ant& ant, oe::Vector2i& goal, oe::EntityHandle& target, bool& blockedEnd)
+{
+	// Same choices as playScout, playWorker and playSoldier
+	target.invalidate();
+	blockedEnd = true;
+	goal = mAnthillPos;
+	if (ant.getResources() > 0)
+	{
+		return;
+	}
+
+	if (ant.getType() == Ant::Soldier || (ant.getType() == Ant::Scout && mTurnNumber >= 15))
+	{
+		target = findTarget(ant);
+		MapEntity* ent = target.getAs<MapEntity>();
+		if (ent != nullptr)
+		{
+			goal = ent->getCoords();
+		}
+		else
+		{
+			target.invalidate();
+		}
+	}
+	else if (findResource(ant, goal) && goal != ant.getCoords())
+	{
+		blockedEnd = false;
 	}
 	else
 	{
-		mCurrentAnt->goToTarget(GameSingleton::anthill);
+		goal = mAnthillPos;
 	}
 }
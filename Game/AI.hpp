@@ -2,6 +2,7 @@
 #define AI_HPP
 
 #include "Ant.hpp"
+#include "CooperativeAStar.hpp"
 #include "GameSingleton.hpp"
 
 class AI
@@ -9,16 +10,25 @@ class AI
 	public:
 		AI();
 
-		void init();
+		// Player 2 against the player, or both players in headless mode
+		void init(U32 player = 2);
+		U32 getPlayer() const;
 
 		void startTurn();
 		void think(oe::Time dt);
 
 		bool isTurnOver() const;
 
+		// All the moves of the turn are planned together at the start of the turn, then the ants move at the same time
+		void setCooperative(bool cooperative);
+		bool isCooperative() const;
+
 		void addResource(const oe::Vector2i& coords);
 
 	private:
+		Ant* getAnt(U32 index);
+		oe::EntityList& getAnts();
+
 		void tryBuy();
 		void tryBuyScout();
 		void tryBuyWorker();
@@ -30,8 +40,17 @@ class AI
 
 		void goToResource();
 		void harass();
+		bool findResource(const Ant& ant, oe::Vector2i& coords);
+		oe::EntityHandle findTarget(const Ant& ant);
+		void requestTargets();
+
+		void planTurn();
+		void playTurn(oe::Time dt);
+		void chooseGoal(const Ant& ant, oe::Vector2i& goal, oe::EntityHandle& target, bool& blockedEnd);
 
 	private:
+		U32 mPlayer;
+		U32 mEnemy;
 		Anthill* mAnthill;
 		Anthill* mAnthillPlayer;
 		oe::Vector2i mAnthillPos;
@@ -43,6 +62,10 @@ class AI
 
 		std::vector<oe::Vector2i> mResourcesPos;
 		oe::EntityList mEnemies;
+
+		bool mCooperative;
+		ReservationTable mReservations;
+		CooperativeAStar mCooperativeSearch;
 };
 
 #endif // AI_HPP
@@ -11,6 +11,11 @@ Ant::Ant(oe::World& world)
 	, mSprite(*this)
 	, mSelectionSprite(*this)
 	, mDestination(invalidDest)
+	, mPlanner()
+	, mPathRequest(PathRequestQueue::InvalidRequest)
+	, mPathRequestStart()
+	, mPathRequestEnd()
+	, mTargetCoords()
 {
 	// Sprite
 	mSprite.setTexture(GameSingleton::antTexture);
@@ -39,6 +44,11 @@ Ant::Ant(oe::World& world)
 	reset();
 }
 
+Ant::~Ant()
+{
+	cancelPathRequest();
+}
+
 void Ant::goTo(I32 x, I32 y)
 {
 	goTo(oe::Vector2i(x, y));
@@ -49,12 +59,36 @@ void Ant::goTo(const oe::Vector2i& coords)
 	invalidateTarget();
 	mPath.clear();
 
-	if (coords.x >= 30 || coords.x < 0 || coords.y >= 30 || coords.y < 0)
+	const oe::Vector2i& size = GameSingleton::collisions.getSize();
+	if (coords.x >= size.x || coords.x < 0 || coords.y >= size.y || coords.y < 0)
 	{
 		return;
 	}
 
-	if (AStar::run(mPath, getCoords(), coords, GameSingleton::collisions))
+	// The incremental planner goes first : it sees the other ants, so the repairs of updateAnt can go around them
+	// Resources have a shared flow field, but an occupied cell can't be reached
+	// Flow fields and the hierarchy only know the walls : the path can cross an ant, the move then stops in front of it (see updateAnt)
+	FlowField* field = GameSingleton::getFlowField(coords);
+	bool found;
+	if (mPlanner != nullptr)
+	{
+		found = GameSingleton::canReach(getCoords(), coords) && mPlanner->run(mPath, getCoords(), coords, GameSingleton::collisions, mPM);
+	}
+	else if (field != nullptr)
+	{
+		found = !GameSingleton::isCollision(coords) && field->getPath(mPath, getCoords());
+	}
+	else if (GameSingleton::useHierarchy())
+	{
+		// Only the steps used this turn are refined, on the walls like the flow fields
+		found = !GameSingleton::isCollision(coords) && GameSingleton::hierarchy.run(mPath, getCoords(), coords, GameSingleton::walls, mPM);
+	}
+	else
+	{
+		found = AStar::run(mPath, getCoords(), coords, GameSingleton::collisions);
+	}
+
+	if (found)
 	{
 		mDestination = coords;
 		if (mPath.size() > mPM)
@@ -76,9 +110,17 @@ void Ant::goToAnthill()
 
 	mPath.clear();
 
-	GameSingleton::setCollision(coords, false);
-	bool a = AStar::run(mPath, getCoords(), coords, GameSingleton::collisions);
-	GameSingleton::setCollision(coords, true);
+	// The flow field of the anthill always accepts the anthill as the end
+	FlowField* field = GameSingleton::getFlowField(coords);
+	bool a;
+	if (field != nullptr)
+	{
+		a = field->getPath(mPath, getCoords());
+	}
+	else
+	{
+		a = AStar::run(mPath, getCoords(), coords, GameSingleton::collisions, true);
+	}
 
 	if (a)
 	{
@@ -122,18 +164,23 @@ void Ant::goToDestination()
 
 void Ant::goToTarget(oe::EntityHandle target)
 {
+	if (target == mTargetHandle && hasTargetPath())
+	{
+		return;
+	}
+
 	mTargetHandle = target;
-	if (!mTargetHandle.isValid())
+	MapEntity* ent = mTargetHandle.getAs<MapEntity>();
+	if (ent == nullptr)
 	{
 		return;
 	}
 
+	cancelPathRequest();
 	mPath.clear();
 	mDestination.set(invalidDest);
 
 	// Adjacent
-	MapEntity* ent = mTargetHandle.getAs<MapEntity>();
-
 	if (canAttack())
 	{
 		attack();
@@ -141,12 +188,8 @@ void Ant::goToTarget(oe::EntityHandle target)
 	}
 
 	oe::Vector2i coords(ent->getCoords());
-
-	GameSingleton::setCollision(coords, false);
-	bool a = AStar::run(mPath, getCoords(), coords, GameSingleton::collisions);
-	GameSingleton::setCollision(coords, true);
-
-	if (a)
+	mTargetCoords = coords;
+	if (AStar::run(mPath, getCoords(), coords, GameSingleton::collisions, true))
 	{
 		if (mPath.back() == coords)
 		{
@@ -163,11 +206,81 @@ void Ant::goToTarget(oe::EntityHandle target)
 	}
 }
 
+void Ant::requestTarget(oe::EntityHandle target)
+{
+	if (target == mTargetHandle && hasTargetPath())
+	{
+		return;
+	}
+
+	cancelPathRequest();
+	mTargetHandle = target;
+	mPath.clear();
+	mDestination.set(invalidDest);
+
+	MapEntity* ent = mTargetHandle.getAs<MapEntity>();
+	if (ent == nullptr)
+	{
+		return;
+	}
+
+	mPathRequestStart = getCoords();
+	mPathRequestEnd = ent->getCoords();
+	mTargetCoords = mPathRequestEnd;
+	mPathRequest = GameSingleton::pathRequests.submit(mPathRequestStart, mPathRequestEnd, true);
+}
+
+bool Ant::isWaitingPath() const
+{
+	return mPathRequest != PathRequestQueue::InvalidRequest;
+}
+
+bool Ant::hasPath() const
+{
+	return !mPath.empty();
+}
+
+bool Ant::hasTargetPath() const
+{
+	const MapEntity* ent = mTargetHandle.getAs<MapEntity>();
+	return ent != nullptr && ent->getCoords() == mTargetCoords && (isWaitingPath() || hasPath());
+}
+
+void Ant::followPath(std::list<oe::Vector2i>& path, const oe::Vector2i& destination, oe::EntityHandle target)
+{
+	cancelPathRequest();
+	mTargetHandle = target;
+	mDestination = destination;
+	mPath.swap(path);
+	if (mPath.size() > mPM)
+	{
+		mPath.resize(mPM);
+	}
+}
+
 void Ant::invalidateTarget()
 {
+	cancelPathRequest();
 	mTargetHandle.invalidate();
 }
 
+void Ant::setIncrementalPath(bool incremental)
+{
+	if (incremental && mPlanner == nullptr)
+	{
+		mPlanner.reset(new DStarLite());
+	}
+	else if (!incremental)
+	{
+		mPlanner.reset();
+	}
+}
+
+bool Ant::hasIncrementalPath() const
+{
+	return mPlanner != nullptr;
+}
+
 bool Ant::canPlay() const
 {
 	return mPM > 0;
@@ -178,6 +291,11 @@ bool Ant::isTurnOver() const
 	return mPM == 0 && !mMoving;
 }
 
+bool Ant::isMoving() const
+{
+	return mMoving;
+}
+
 void Ant::endTurn()
 {
 	mPM = 0;
@@ -189,6 +307,7 @@ void Ant::reset()
 	mPM = getDistance();
 	mMoving = false;
 	mCanAttack = true;
+	cancelPathRequest();
 	mTargetHandle.invalidate();
 }
 
@@ -240,7 +359,7 @@ void Ant::attack()
 	if (ent->getLife() == 0 && ent->getCoords() != getAnthillEnemy().getCoords())
 	{
 		ent->kill();
-		GameSingleton::setCollision(ent->getCoords(), false);
+		GameSingleton::setUnitCollision(ent->getCoords(), false);
 		if (getPlayer() == 1)
 		{
 			GameSingleton::map->setTileOverlayId(ent->getCoords(), TILE_OVER1);
@@ -252,23 +371,41 @@ void Ant::attack()
 	{
 		mPM = 0;
 		mMoving = false;
+		mPath.clear();
 	}
 }
 
 bool Ant::updateAnt(oe::Time dt, bool selected)
 {
 	selectedOverlay(selected); // Selection (+ zone of movement if can play && selected)
+	if (isWaitingPath())
+	{
+		receivePath();
+		if (isWaitingPath())
+		{
+			return false;
+		}
+	}
 	if (!mPath.empty() || mMoving) // We need to move
 	{
 		if (!mMoving)
 		{
 			mTime = oe::Time::Zero;
 			oe::Vector2i coords(mPath.front());
-			if (!GameSingleton::isCollision(coords))
+			if (coords == getCoords())
+			{
+				// Wait for the other ants during this step
+				mPM--;
+				mPath.pop_front();
+				mStart.set(GameSingleton::map->coordsToWorld(coords));
+				mEnd.set(mStart);
+				mMoving = true;
+			}
+			else if (!GameSingleton::isCollision(coords))
 			{
-				GameSingleton::setCollision(getCoords(), false);
-				GameSingleton::setCollision(coords, true);
-				mCoords.set(coords);
+				GameSingleton::setUnitCollision(getCoords(), false);
+				GameSingleton::setUnitCollision(coords, true);
+				setCellCoords(coords);
 				mPM--;
 				mPath.pop_front();
 
@@ -282,6 +419,12 @@ bool Ant::updateAnt(oe::Time dt, bool selected)
 				mEnd.set(GameSingleton::map->coordsToWorld(coords));
 				mMoving = true;
 			}
+			else if (mPlanner != nullptr && mDestination != invalidDest && mDestination != coords)
+			{
+				// Repair the path now, only the changed cells are searched again
+				goTo(mDestination);
+				mMoving = false;
+			}
 			else
 			{
 				mPath.clear();
@@ -290,6 +433,8 @@ bool Ant::updateAnt(oe::Time dt, bool selected)
 		}
 		else
 		{
+			// Simulation time : a move takes the same number of steps on every machine
+			// With a slow update rate a step can jump over time1, the rendering interpolates it
 			mTime += dt;
 			static const oe::Time time1(oe::seconds(0.10f));
 			static const oe::Time time2(oe::seconds(0.15f));
@@ -297,7 +442,11 @@ bool Ant::updateAnt(oe::Time dt, bool selected)
 			{
 				setPosition(oe::Vector2::lerp(mStart, mEnd, mTime.asSeconds() * 10.f));
 			}
-			else if (mTime > time2)
+			else if (mTime <= time2)
+			{
+				setPosition(mEnd);
+			}
+			else
 			{
 				mMoving = false;
 
@@ -393,16 +542,7 @@ const oe::Vector2i& Ant::getDestination() const
 
 bool Ant::isAdjacent(const oe::Vector2i& coords) const
 {
-	std::vector<oe::Vector2i> n;
-	oe::MapUtility::getNeighboors(n, getCoords(), oe::MapUtility::Hexagonal);
-	for (const oe::Vector2i& c : n)
-	{
-		if (c == coords)
-		{
-			return true;
-		}
-	}
-	return false;
+	return oe::MapUtility::areHexNeighbors(getCoords(), coords);
 }
 
 U32 Ant::getPrice(Type antType)
@@ -465,6 +605,43 @@ U32 Ant::getDamage(Type antType)
 	return 0;
 }
 
+void Ant::receivePath()
+{
+	PathRequestQueue& requests = GameSingleton::pathRequests;
+	switch (requests.getStatus(mPathRequest))
+	{
+		case PathRequestQueue::Status::Pending: return;
+		case PathRequestQueue::Status::Done:
+		{
+			std::list<oe::Vector2i> path;
+			// The path starts from the cell of the request
+			if (requests.takeResult(mPathRequest, path) && mPathRequestStart == getCoords())
+			{
+				if (path.back() == mPathRequestEnd)
+				{
+					path.pop_back();
+				}
+				if (path.size() > mPM)
+				{
+					path.resize(mPM);
+				}
+				mPath.swap(path);
+			}
+		} break;
+		default: break;
+	}
+	mPathRequest = PathRequestQueue::InvalidRequest;
+}
+
+void Ant::cancelPathRequest()
+{
+	if (mPathRequest != PathRequestQueue::InvalidRequest)
+	{
+		GameSingleton::pathRequests.cancel(mPathRequest);
+		mPathRequest = PathRequestQueue::InvalidRequest;
+	}
+}
+
 void Ant::selectedOverlay(bool displayMovements)
 {
 	if (canPlay() && displayMovements && !GameSingleton::map->isOverlayValid())
@@ -490,6 +667,7 @@ void Ant::tryCollectResources()
 		{
 			addResources(resources);
 			r->setResources(0);
+			GameSingleton::flowFields.remove(r->getCoords());
 			r->kill();
 		}
 		else // resource >= antCap
@@ -498,6 +676,7 @@ void Ant::tryCollectResources()
 			r->takeResources(antCap);
 			if (r->getResources() <= 0)
 			{
+				GameSingleton::flowFields.remove(r->getCoords());
 				r->kill();
 			}
 		}
@@ -507,15 +686,10 @@ void Ant::tryCollectResources()
 void Ant::tryDeposit()
 {
 	Anthill& anthill(getAnthill());
-	std::vector<oe::Vector2i> n;
-	oe::MapUtility::getNeighboors(n, anthill.getCoords(), oe::MapUtility::Hexagonal);
-	for (const oe::Vector2i& c : n)
+	if (oe::MapUtility::areHexNeighbors(anthill.getCoords(), getCoords()))
 	{
-		if (c == getCoords())
-		{
-			anthill.addResources(getResources());
-			setResources(0);
-		}
+		anthill.addResources(getResources());
+		setResources(0);
 	}
 }
 
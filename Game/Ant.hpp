@@ -2,14 +2,21 @@
 #define ANT_HPP
 
 #include "MapEntity.hpp"
+#include "DStarLite.hpp"
+#include "PathRequestQueue.hpp"
 #include "Pathfinding.hpp"
 
+#include <memory>
+
 class Anthill;
 
 class Ant : public MapEntity
 {
+	OeEntity(Ant, MapEntity)
+
 	public:
 		Ant(oe::World& world);
+		~Ant();
 
 		static const oe::Vector2i invalidDest;
 
@@ -24,12 +31,29 @@ class Ant : public MapEntity
 		void goTo(const oe::Vector2i& coords);
 		void goToAnthill();
 		void goToDestination();
+		// Player commands : the path to the target is solved now, attacks when adjacent
 		void goToTarget(oe::EntityHandle target);
 
+		// AI : the path to the target is solved by the workers and followed from the next frame, never attacks
+		void requestTarget(oe::EntityHandle target);
+		bool isWaitingPath() const;
+		bool hasPath() const;
+
+		// A path to the target is followed or solved, and the target is still in the cell it was searched for
+		bool hasTargetPath() const;
+
+		// Path planned with the other ants of the side (see CooperativeAStar), a repeated cell is a wait
+		void followPath(std::list<oe::Vector2i>& path, const oe::Vector2i& destination, oe::EntityHandle target = oe::EntityHandle());
+
 		void invalidateTarget();
 
+		// Keep the search of goTo between turns, and repair it when collisions change
+		void setIncrementalPath(bool incremental);
+		bool hasIncrementalPath() const;
+
 		bool canPlay() const;
 		bool isTurnOver() const;
+		bool isMoving() const;
 		void endTurn();
 		void reset();
 		void resetDest();
@@ -63,6 +87,9 @@ class Ant : public MapEntity
 		static U32 getDamage(Type antType);
 
 	private:
+		void receivePath();
+		void cancelPathRequest();
+
 		void selectedOverlay(bool displayMovements);
 		void tryCollectResources();
 		void tryDeposit();
@@ -78,6 +105,11 @@ class Ant : public MapEntity
 		U32 mPM;
 		oe::Vector2i mDestination;
 		std::list<oe::Vector2i> mPath;
+		std::unique_ptr<DStarLite> mPlanner;
+		PathRequestQueue::RequestId mPathRequest;
+		oe::Vector2i mPathRequestStart;
+		oe::Vector2i mPathRequestEnd;
+		oe::Vector2i mTargetCoords; // Cell of the target when its path was searched
 
 		oe::Time mTime;
 		bool mMoving;
@@ -40,21 +40,15 @@ bool Anthill::canSpawn(Ant::Type antType)
 
 bool Anthill::spawn(Ant::Type antType)
 {
-	std::vector<oe::Vector2i> n;
-	oe::MapUtility::getNeighboors(n, getCoords(), oe::MapUtility::Hexagonal);
-	U32 size = n.size();
-	for (U32 i = 0; i < size;)
+	oe::FrameVector<oe::Vector2i> n;
+	n.reserve(oe::MapUtility::HexNeighborCount);
+	oe::MapUtility::forEachHexNeighbor(getCoords(), [&n](const oe::Vector2i& neighbor)
 	{
-		if (GameSingleton::isCollision(n[i]))
-		{
-			n.erase(n.begin() + i);
-			size--;
-		}
-		else
+		if (!GameSingleton::isCollision(neighbor))
 		{
-			i++;
+			n.push_back(neighbor);
 		}
-	}
+	});
 	if (n.size() > 0) 
 	{
 		oe::Vector2i coords(n[oe::Random::get(0u, n.size() - 1)]);
@@ -65,7 +59,8 @@ bool Anthill::spawn(Ant::Type antType)
 			a->setCoords(coords);
 			a->setPlayer(getPlayer());
 			a->setType(antType);
-			GameSingleton::setCollision(coords, true);
+			a->setIncrementalPath(DSTARLITEPATH);
+			GameSingleton::setUnitCollision(coords, true);
 			if (getPlayer() == 1)
 			{
 				GameSingleton::ants.insert(ant);
@@ -74,6 +69,12 @@ bool Anthill::spawn(Ant::Type antType)
 			{
 				GameSingleton::aiAnts.insert(ant);
 			}
+
+			// Every ant can move between two queries of a planner, the journal must keep all the moves
+			if (a->hasIncrementalPath())
+			{
+				GameSingleton::collisions.reserveJournal((GameSingleton::ants.size() + GameSingleton::aiAnts.size()) * DSTARLITEJOURNAL);
+			}
 			takeResources(Ant::getPrice(antType));
 			return true;
 		}
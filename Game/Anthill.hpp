@@ -7,6 +7,8 @@
 
 class Anthill : public MapEntity
 {
+	OeEntity(Anthill, MapEntity)
+
 	public:
 		Anthill(oe::World& world);
 
@@ -0,0 +1,302 @@
+#include "Connectivity.hpp"
+
+const U32 ConnectivityIndex::NoComponent;
+const U32 ConnectivityIndex::MaxSearch;
+
+ConnectivityIndex::ConnectivityIndex()
+	: mLabels()
+	, mParents()
+	, mQueue()
+	, mMarks()
+	, mMark(0)
+	, mOtherQueue()
+{
+}
+
+void ConnectivityIndex::build(const CollisionMatrix& map)
+{
+	const oe::Vector2i& size = map.getSize();
+	mLabels.create(size, NoComponent);
+	mParents.clear();
+	mMarks.create(size, 0);
+	mMark = 0;
+	oe::Vector2i coords;
+	for (coords.y = 0; coords.y < size.y; coords.y++)
+	{
+		for (coords.x = 0; coords.x < size.x; coords.x++)
+		{
+			if (!map.get(coords) && mLabels[coords] == NoComponent)
+			{
+				flood(coords, createComponent(), NoComponent, map);
+			}
+		}
+	}
+}
+
+void ConnectivityIndex::clear()
+{
+	mLabels.clear();
+	mParents.clear();
+	mMarks.clear();
+	mMark = 0;
+}
+
+bool ConnectivityIndex::isBuilt() const
+{
+	return !mLabels.empty();
+}
+
+void ConnectivityIndex::onCollisionChanged(const oe::Vector2i& coords, bool value, const CollisionMatrix& map)
+{
+	if (!mLabels.contains(coords) || mLabels.getSize() != map.getSize())
+	{
+		return;
+	}
+
+	const U32 label = mLabels[coords];
+	if (!value)
+	{
+		if (label != NoComponent)
+		{
+			return;
+		}
+
+		// The freed cell joins all the regions around it
+		U32 root = NoComponent;
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+		{
+			const U32 neighborLabel = mLabels.get(neighbor, NoComponent);
+			if (neighborLabel == NoComponent)
+			{
+				continue;
+			}
+			const U32 neighborRoot = find(neighborLabel);
+			if (root == NoComponent)
+			{
+				root = neighborRoot;
+			}
+			else if (neighborRoot != root)
+			{
+				mParents[neighborRoot] = root;
+			}
+		}
+		mLabels[coords] = (root != NoComponent) ? root : createComponent();
+	}
+	else
+	{
+		if (label == NoComponent)
+		{
+			return;
+		}
+
+		const U32 previous = find(label);
+		mLabels[coords] = NoComponent;
+
+		// Neighbors are given in ring order : if the free ones form a single arc, they stay connected around the cell
+		const oe::MapUtility::HexNeighbors neighbors(coords);
+		const U32 count = neighbors.size();
+		oe::Vector2i arcs[oe::MapUtility::HexNeighborCount];
+		U32 arcCount = 0;
+		for (U32 i = 0; i < count; i++)
+		{
+			const bool free = mLabels.get(neighbors[i], NoComponent) != NoComponent;
+			const bool previousFree = mLabels.get(neighbors[(i + count - 1) % count], NoComponent) != NoComponent;
+			if (free && !previousFree)
+			{
+				arcs[arcCount++] = neighbors[i];
+			}
+		}
+		if (arcCount <= 1)
+		{
+			return;
+		}
+
+		// The region might be split : the arcs usually meet again a few cells away, look for it before relabeling
+		// An arc cut from the kept one gets a new label, or the kept one does when its side is the one closed
+		oe::Vector2i kept = arcs[arcCount - 1];
+		for (U32 i = 0; i + 1 < arcCount; i++)
+		{
+			const oe::Vector2i& start = arcs[i];
+			if (find(mLabels[start]) != previous)
+			{
+				continue;
+			}
+			const Search result = search(start, kept, map);
+			if (result == Search::ClosedB)
+			{
+				flood(kept, createComponent(), previous, map);
+				kept = start;
+			}
+			else if (result != Search::Connected)
+			{
+				flood(start, createComponent(), previous, map);
+			}
+		}
+
+		// Relabeling leaves dead components behind, start over when there are too many
+		if (mParents.size() > 2 * mLabels.getCellCount() + 64)
+		{
+			build(map);
+		}
+	}
+}
+
+bool ConnectivityIndex::canReach(const oe::Vector2i& start, const oe::Vector2i& end) const
+{
+	if (!isBuilt() || AStar::distance(start, end) <= 1) // Next to each other, even if both are walls
+	{
+		return true;
+	}
+	U32 startComponents[6];
+	U32 endComponents[6];
+	const U32 startCount = getComponents(start, startComponents);
+	const U32 endCount = getComponents(end, endComponents);
+	for (U32 i = 0; i < startCount; i++)
+	{
+		for (U32 j = 0; j < endCount; j++)
+		{
+			if (startComponents[i] == endComponents[j])
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+U32 ConnectivityIndex::getComponent(const oe::Vector2i& coords) const
+{
+	const U32 label = mLabels.get(coords, NoComponent);
+	return (label != NoComponent) ? find(label) : NoComponent;
+}
+
+U32 ConnectivityIndex::find(U32 component) const
+{
+	while (mParents[component] != component)
+	{
+		mParents[component] = mParents[mParents[component]]; // Path halving
+		component = mParents[component];
+	}
+	return component;
+}
+
+U32 ConnectivityIndex::createComponent()
+{
+	const U32 component = mParents.size();
+	mParents.push_back(component);
+	return component;
+}
+
+U32 ConnectivityIndex::getComponents(const oe::Vector2i& coords, U32* components) const
+{
+	if (!mLabels.contains(coords))
+	{
+		return 0;
+	}
+	const U32 label = mLabels[coords];
+	if (label != NoComponent)
+	{
+		components[0] = find(label);
+		return 1;
+	}
+
+	U32 count = 0;
+	for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+	{
+		const U32 neighborLabel = mLabels.get(neighbor, NoComponent);
+		if (neighborLabel != NoComponent && count < 6)
+		{
+			components[count++] = find(neighborLabel);
+		}
+	}
+	return count;
+}
+
+void ConnectivityIndex::flood(const oe::Vector2i& start, U32 component, U32 previous, const CollisionMatrix& map)
+{
+	mQueue.clear();
+	mLabels[start] = component;
+	mQueue.push_back(mLabels.toIndex(start));
+	for (U32 i = 0; i < mQueue.size(); i++)
+	{
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(mLabels.toCoords(mQueue[i])))
+		{
+			if (map.get(neighbor)) // Wall or outside of the map
+			{
+				continue;
+			}
+			const U32 index = mLabels.toIndex(neighbor);
+			const U32 label = mLabels[index];
+			const bool matches = (previous == NoComponent) ? label == NoComponent : (label != NoComponent && label != component && find(label) == previous);
+			if (matches)
+			{
+				mLabels[index] = component;
+				mQueue.push_back(index);
+			}
+		}
+	}
+}
+
+ConnectivityIndex::Search ConnectivityIndex::search(const oe::Vector2i& a, const oe::Vector2i& b, const CollisionMatrix& map)
+{
+	// Stamps instead of clearing the marks at each search
+	if (mMark >= 0xFFFFFFFF - 2)
+	{
+		mMarks.fill(0);
+		mMark = 0;
+	}
+	mMark += 2;
+	const U32 markA = mMark;
+	const U32 markB = mMark + 1;
+
+	mQueue.clear();
+	mOtherQueue.clear();
+	mQueue.push_back(mMarks.toIndex(a));
+	mOtherQueue.push_back(mMarks.toIndex(b));
+	mMarks[a] = markA;
+	mMarks[b] = markB;
+	U32 nextA = 0;
+	U32 nextB = 0;
+	U32 visited = 2;
+
+	// The smaller frontier grows first : a closed pocket is found after visiting it only
+	while (visited < MaxSearch)
+	{
+		const bool closedA = nextA == mQueue.size();
+		const bool closedB = nextB == mOtherQueue.size();
+		if (closedA || closedB)
+		{
+			return closedA ? Search::ClosedA : Search::ClosedB;
+		}
+		const bool growA = mQueue.size() - nextA <= mOtherQueue.size() - nextB;
+		const bool met = growA ? expand(mQueue, nextA, markA, markB, map, visited) : expand(mOtherQueue, nextB, markB, markA, map, visited);
+		if (met)
+		{
+			return Search::Connected;
+		}
+	}
+	return Search::Stopped;
+}
+
+bool ConnectivityIndex::expand(std::vector<U32>& queue, U32& next, U32 mark, U32 other, const CollisionMatrix& map, U32& visited)
+{
+	for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(mMarks.toCoords(queue[next++])))
+	{
+		if (map.get(neighbor)) // Wall or outside of the map
+		{
+			continue;
+		}
+		const U32 index = mMarks.toIndex(neighbor);
+		if (mMarks[index] == other)
+		{
+			return true;
+		}
+		if (mMarks[index] != mark)
+		{
+			mMarks[index] = mark;
+			queue.push_back(index);
+			visited++;
+		}
+	}
+	return false;
+}
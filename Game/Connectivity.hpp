@@ -0,0 +1,56 @@
+#ifndef CONNECTIVITY_HPP
+#define CONNECTIVITY_HPP
+
+#include "Pathfinding.hpp"
+
+// Label of the connected region of each free cell, kept up to date when a cell changes
+// Regions are merged with a union-find when a cell is freed, and relabeled only when blocking a cell really splits a region
+// Built on the walls : the ants move at each step and would relabel the regions all the time
+class ConnectivityIndex
+{
+	public:
+		static const U32 NoComponent = 0xFFFFFFFF;
+
+		ConnectivityIndex();
+
+		void build(const CollisionMatrix& map);
+		void clear();
+		bool isBuilt() const;
+
+		// Must be called after the cell has been changed in the map
+		void onCollisionChanged(const oe::Vector2i& coords, bool value, const CollisionMatrix& map);
+
+		// Walls (an anthill, a resource) are reached through their free neighbors, or directly when adjacent
+		bool canReach(const oe::Vector2i& start, const oe::Vector2i& end) const;
+		U32 getComponent(const oe::Vector2i& coords) const;
+
+	private:
+		U32 find(U32 component) const;
+		U32 createComponent();
+		U32 getComponents(const oe::Vector2i& coords, U32* components) const;
+		void flood(const oe::Vector2i& start, U32 component, U32 previous, const CollisionMatrix& map);
+
+		// Bidirectional breadth-first search between two free cells, stopped after MaxSearch cells
+		enum class Search
+		{
+			Connected,
+			ClosedA, // Every cell reached from a was visited : a is cut from b
+			ClosedB,
+			Stopped
+		};
+		Search search(const oe::Vector2i& a, const oe::Vector2i& b, const CollisionMatrix& map);
+		bool expand(std::vector<U32>& queue, U32& next, U32 mark, U32 other, const CollisionMatrix& map, U32& visited);
+
+		static const U32 MaxSearch = 1024;
+
+	private:
+		oe::HexGrid<U32> mLabels;
+		mutable std::vector<U32> mParents;
+		std::vector<U32> mQueue;
+
+		oe::HexGrid<U32> mMarks; // Cells visited by the search of the stamp mMark (side a) or mMark + 1 (side b)
+		U32 mMark;
+		std::vector<U32> mOtherQueue;
+};
+
+#endif // CONNECTIVITY_HPP
@@ -0,0 +1,403 @@
+#include "CooperativeAStar.hpp"
+
+#include <algorithm>
+
+const U32 ReservationTable::NoOwner;
+const I32 CooperativeAStar::Unreachable;
+const U32 CooperativeAStar::InvalidIndex;
+
+ReservationTable::ReservationTable()
+	: mAgentCells()
+	, mReservations()
+	, mParkings()
+	, mAgents()
+	, mHorizon(0)
+{
+}
+
+void ReservationTable::create(const oe::Vector2i& size)
+{
+	if (mAgentCells.getSize() != size)
+	{
+		mAgentCells.create(size, false);
+	}
+	clear();
+}
+
+void ReservationTable::clear()
+{
+	mAgentCells.fill(false);
+	mReservations.clear();
+	mParkings.clear();
+	mAgents.clear();
+	mHorizon = 0;
+}
+
+void ReservationTable::addAgent(U32 owner, const oe::Vector2i& coords)
+{
+	if (mAgentCells.contains(coords))
+	{
+		const U32 index = mAgentCells.toIndex(coords);
+		mAgentCells.set(coords, true);
+		mParkings[index] = { owner, 0 };
+		mAgents[owner].parkings.push_back(index);
+	}
+}
+
+void ReservationTable::reservePath(U32 owner, const oe::Vector2i& start, U32 startTime, const std::list<oe::Vector2i>& path)
+{
+	if (!mAgentCells.contains(start))
+	{
+		return;
+	}
+	Agent& agent = mAgents[owner];
+	U32 time = startTime;
+	U32 last = mAgentCells.toIndex(start);
+	mReservations[toKey(last, time)] = owner;
+	agent.reservations.push_back(toKey(last, time));
+	for (const oe::Vector2i& coords : path)
+	{
+		time++;
+		last = mAgentCells.toIndex(coords);
+		mReservations[toKey(last, time)] = owner;
+		agent.reservations.push_back(toKey(last, time));
+	}
+	mParkings[last] = { owner, time };
+	agent.parkings.push_back(last);
+	mHorizon = std::max(mHorizon, time);
+}
+
+void ReservationTable::release(U32 owner)
+{
+	auto agent = mAgents.find(owner);
+	if (agent == mAgents.end())
+	{
+		return;
+	}
+
+	// Another agent may have taken an entry since : only the ones still owned are removed
+	for (U64 key : agent->second.reservations)
+	{
+		auto reservation = mReservations.find(key);
+		if (reservation != mReservations.end() && reservation->second == owner)
+		{
+			mReservations.erase(reservation);
+		}
+	}
+	for (U32 index : agent->second.parkings)
+	{
+		auto parking = mParkings.find(index);
+		if (parking != mParkings.end() && parking->second.owner == owner)
+		{
+			mParkings.erase(parking);
+		}
+	}
+	agent->second.reservations.clear();
+	agent->second.parkings.clear();
+}
+
+bool ReservationTable::isReserved(const oe::Vector2i& coords, U32 time, U32 owner) const
+{
+	if (!mAgentCells.contains(coords))
+	{
+		return false;
+	}
+	const U32 index = mAgentCells.toIndex(coords);
+	auto reservation = mReservations.find(toKey(index, time));
+	if (reservation != mReservations.end() && reservation->second != owner)
+	{
+		return true;
+	}
+	auto parking = mParkings.find(index);
+	return parking != mParkings.end() && parking->second.owner != owner && parking->second.from <= time;
+}
+
+bool ReservationTable::isAgentCell(const oe::Vector2i& coords) const
+{
+	return mAgentCells.get(coords, false);
+}
+
+U32 ReservationTable::getHorizon() const
+{
+	return mHorizon;
+}
+
+U64 ReservationTable::toKey(U32 index, U32 time)
+{
+	return (static_cast<U64>(index) << 32) | time;
+}
+
+CooperativeAStar::Stats::Stats()
+	: expansions(0)
+	, queries(0)
+	, totalExpansions(0)
+	, fields(0)
+{
+}
+
+CooperativeAStar::CooperativeAStar()
+	: mDistances()
+	, mDistanceSlots()
+	, mMapVersion(0)
+	, mQueue()
+	, mCells()
+	, mNodes()
+	, mOpen()
+	, mStart()
+	, mEnd()
+	, mWindow(0)
+	, mGeneration(0)
+	, mStats()
+{
+}
+
+void CooperativeAStar::newTurn()
+{
+	mDistanceSlots.clear();
+	mStats.fields = 0;
+}
+
+bool CooperativeAStar::run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map,
+	const ReservationTable& reservations, U32 owner, U32 startTime, U32 window, bool blockedEnd)
+{
+	path.clear();
+	mStats.expansions = 0;
+	mStats.queries++;
+
+	const oe::HexGrid<bool>& grid = map.getGrid();
+	if (window == 0 || start == end || !grid.contains(start) || !grid.contains(end))
+	{
+		return false;
+	}
+	mStart = start;
+	mEnd = end;
+	mWindow = window;
+	if (!blockedEnd && isWall(end, map, reservations))
+	{
+		return false;
+	}
+
+	// The start is never a wall for its own search (see isWall) : when it is not an agent cell, it is reached from its neighbors
+	const oe::HexGrid<I32>& distances = getDistances(end, map, reservations);
+	I32 startDistance = distances[start];
+	if (startDistance == Unreachable)
+	{
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(start))
+		{
+			const I32 distance = distances.get(neighbor, Unreachable);
+			if (distance != Unreachable && (startDistance == Unreachable || distance + 1 < startDistance))
+			{
+				startDistance = distance + 1;
+			}
+		}
+		if (startDistance == Unreachable)
+		{
+			return false;
+		}
+	}
+
+	// A cell is visited at most once at each step : all the paths to a node have the same length
+	// Only the cells are stamped, the nodes of a cell at each step are allocated when they are reached
+	mGeneration++;
+	if (mCells.getSize() != grid.getSize() || mGeneration == 0)
+	{
+		mCells.create(grid.getSize(), Cell{ 0, InvalidIndex });
+		mGeneration = 1;
+	}
+	mNodes.clear();
+
+	const U32 startNode = addNode(grid.toIndex(start), 0, InvalidIndex);
+	mOpen.clear();
+	// Sorted by estimate, then by step : on equal estimates the deepest node is expanded first
+	const I32 steps = static_cast<I32>(window) + 1;
+	mOpen.emplace_back(startDistance * steps + static_cast<I32>(window), startNode);
+
+	U32 found = InvalidIndex;
+	while (!mOpen.empty())
+	{
+		std::pop_heap(mOpen.begin(), mOpen.end(), std::greater<std::pair<I32, U32>>());
+		const U32 current = mOpen.back().second;
+		mOpen.pop_back();
+
+		const U32 step = mNodes[current].step;
+		const oe::Vector2i coords(grid.toCoords(mNodes[current].cell));
+		if (coords == end && (blockedEnd || canPark(coords, startTime + step, owner, reservations)))
+		{
+			found = current;
+			break;
+		}
+		if (step == window)
+		{
+			// The window is over : the best cell is the one where the agent can stay
+			if (coords != end && canPark(coords, startTime + step, owner, reservations))
+			{
+				found = current;
+				break;
+			}
+			continue;
+		}
+		mStats.expansions++;
+
+		const U32 time = startTime + step + 1;
+		const oe::MapUtility::HexNeighbors neighbors(coords);
+		for (U32 i = 0; i <= neighbors.size(); i++)
+		{
+			const oe::Vector2i neighbor = (i < neighbors.size()) ? neighbors[i] : coords; // The last one is a wait
+			if (!grid.contains(neighbor))
+			{
+				continue;
+			}
+			// Agents move one after the other during a step : a cell can't be entered at the step it is left
+			// The end of a target is never reserved, the other cells must be free at this step and at the previous one
+			if (!(blockedEnd && neighbor == end))
+			{
+				if (isWall(neighbor, map, reservations) || reservations.isReserved(neighbor, time, owner)
+					|| (neighbor != coords && reservations.isReserved(neighbor, time - 1, owner)))
+				{
+					continue;
+				}
+			}
+			if (neighbor != coords && reservations.isReserved(coords, time, owner))
+			{
+				continue;
+			}
+			const I32 distance = distances[neighbor];
+			const U32 cell = grid.toIndex(neighbor);
+			if (distance == Unreachable || hasNode(cell, step + 1))
+			{
+				continue;
+			}
+			const U32 node = addNode(cell, step + 1, current);
+			mOpen.emplace_back((static_cast<I32>(step + 1) + distance) * steps + static_cast<I32>(window - step - 1), node);
+			std::push_heap(mOpen.begin(), mOpen.end(), std::greater<std::pair<I32, U32>>());
+		}
+	}
+	mStats.totalExpansions += mStats.expansions;
+
+	if (found == InvalidIndex)
+	{
+		return false;
+	}
+	for (U32 node = found; node != startNode; node = mNodes[node].parent)
+	{
+		path.push_front(grid.toCoords(mNodes[node].cell));
+	}
+	return true;
+}
+
+const CooperativeAStar::Stats& CooperativeAStar::getStats() const
+{
+	return mStats;
+}
+
+U32 CooperativeAStar::addNode(U32 cell, U32 step, U32 parent)
+{
+	Cell& entry = mCells[cell];
+	if (entry.generation != mGeneration)
+	{
+		entry = { mGeneration, InvalidIndex };
+	}
+	const U32 node = static_cast<U32>(mNodes.size());
+	mNodes.push_back({ cell, step, parent, entry.first });
+	entry.first = node;
+	return node;
+}
+
+bool CooperativeAStar::hasNode(U32 cell, U32 step) const
+{
+	// At most window + 1 nodes by cell, usually one or two
+	const Cell& entry = mCells[cell];
+	if (entry.generation != mGeneration)
+	{
+		return false;
+	}
+	for (U32 node = entry.first; node != InvalidIndex; node = mNodes[node].next)
+	{
+		if (mNodes[node].step == step)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+const oe::HexGrid<I32>& CooperativeAStar::getDistances(const oe::Vector2i& end, const CollisionMatrix& map, const ReservationTable& reservations)
+{
+	if (map.getVersion() != mMapVersion)
+	{
+		mDistanceSlots.clear();
+		mMapVersion = map.getVersion();
+	}
+
+	auto slot = mDistanceSlots.find(toKey(end));
+	if (slot != mDistanceSlots.end() && mDistances[slot->second].getSize() == map.getSize())
+	{
+		return mDistances[slot->second];
+	}
+
+	// The grids of the previous turns are reused
+	const U32 index = (slot != mDistanceSlots.end()) ? slot->second : static_cast<U32>(mDistanceSlots.size());
+	if (index >= mDistances.size())
+	{
+		mDistances.emplace_back();
+	}
+	mDistanceSlots[toKey(end)] = index;
+	computeDistances(mDistances[index], end, map, reservations);
+	mStats.fields++;
+	return mDistances[index];
+}
+
+void CooperativeAStar::computeDistances(oe::HexGrid<I32>& distances, const oe::Vector2i& end, const CollisionMatrix& map, const ReservationTable& reservations)
+{
+	if (distances.getSize() != map.getSize())
+	{
+		distances.create(map.getSize(), Unreachable);
+	}
+	else
+	{
+		distances.fill(Unreachable);
+	}
+
+	// Breadth-first search from the end, the agents are ignored
+	// The start of the query is not used : the same distances serve every agent going to this end
+	mQueue.clear();
+	mQueue.push_back(distances.toIndex(end));
+	distances[end] = 0;
+	for (U32 i = 0; i < mQueue.size(); i++)
+	{
+		const oe::Vector2i coords(distances.toCoords(mQueue[i]));
+		const I32 distance = distances[mQueue[i]] + 1;
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+		{
+			if (distances.contains(neighbor) && distances[neighbor] == Unreachable && !(map.get(neighbor) && !reservations.isAgentCell(neighbor)))
+			{
+				distances[neighbor] = distance;
+				mQueue.push_back(distances.toIndex(neighbor));
+			}
+		}
+	}
+}
+
+bool CooperativeAStar::isWall(const oe::Vector2i& coords, const CollisionMatrix& map, const ReservationTable& reservations) const
+{
+	return coords != mStart && map.get(coords) && !reservations.isAgentCell(coords);
+}
+
+bool CooperativeAStar::canPark(const oe::Vector2i& coords, U32 time, U32 owner, const ReservationTable& reservations) const
+{
+	// Nobody else can use the cell until the end of the reservations
+	const U32 horizon = std::max(reservations.getHorizon(), time + mWindow);
+	for (U32 t = time; t <= horizon; t++)
+	{
+		if (reservations.isReserved(coords, t, owner))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+U64 CooperativeAStar::toKey(const oe::Vector2i& end)
+{
+	return (static_cast<U64>(static_cast<U32>(end.x)) << 32) | static_cast<U64>(static_cast<U32>(end.y));
+}
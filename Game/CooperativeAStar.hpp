@@ -0,0 +1,132 @@
+#ifndef COOPERATIVEASTAR_HPP
+#define COOPERATIVEASTAR_HPP
+
+#include "Pathfinding.hpp"
+
+#include <unordered_map>
+
+// Cells reserved by the agents of one side at each step of the turn
+// An agent stays on its cell after its last reserved step (parked)
+class ReservationTable
+{
+	public:
+		static const U32 NoOwner = 0xFFFFFFFF;
+
+		ReservationTable();
+
+		void create(const oe::Vector2i& size);
+		void clear();
+
+		// The agent is parked on its cell until it plans, its cell is not a wall for the other agents
+		void addAgent(U32 owner, const oe::Vector2i& coords);
+
+		// Each cell of the path at its step, then parked on the last cell
+		void reservePath(U32 owner, const oe::Vector2i& start, U32 startTime, const std::list<oe::Vector2i>& path);
+		void release(U32 owner);
+
+		// Reserved by another agent
+		bool isReserved(const oe::Vector2i& coords, U32 time, U32 owner) const;
+		bool isAgentCell(const oe::Vector2i& coords) const;
+
+		// Last reserved step
+		U32 getHorizon() const;
+
+	private:
+		static U64 toKey(U32 index, U32 time);
+
+		struct Parking
+		{
+			U32 owner;
+			U32 from;
+		};
+
+		// What an agent holds in the tables : release only looks at these
+		struct Agent
+		{
+			std::vector<U64> reservations;
+			std::vector<U32> parkings;
+		};
+
+	private:
+		oe::HexGrid<bool> mAgentCells;
+		std::unordered_map<U64, U32> mReservations;
+		std::unordered_map<U32, Parking> mParkings;
+		std::unordered_map<U32, Agent> mAgents;
+		U32 mHorizon;
+};
+
+// Windowed cooperative A* (WHCA*) : the search runs in space and time, over the next window steps only
+// Waiting on a cell is a step, the cells reserved by the other agents are avoided at each step
+// The heuristic is the true distance to the end without the agents, computed once per end until the next turn
+class CooperativeAStar
+{
+	public:
+		struct Stats
+		{
+			Stats();
+
+			U32 expansions; // Last query
+			U32 queries;
+			U64 totalExpansions;
+			U32 fields; // Distances computed since the last turn
+		};
+
+		CooperativeAStar();
+
+		// The walls and the agents must not change until the next turn : the distances to an end are reused until then
+		void newTurn();
+
+		// Same format as AStar::run, but the path has at most window steps and can repeat a cell (wait)
+		// The path ends on the end, or on the best cell reached after window steps
+		bool run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map,
+			const ReservationTable& reservations, U32 owner, U32 startTime, U32 window, bool blockedEnd = false);
+
+		const Stats& getStats() const;
+
+	private:
+		static const I32 Unreachable = -1;
+		static const U32 InvalidIndex = 0xFFFFFFFF;
+
+		// A cell at one step, taken from mNodes when the search reaches it
+		struct Node
+		{
+			U32 cell;
+			U32 step;
+			U32 parent;
+			U32 next; // Next node of the same cell
+		};
+
+		// First node of the cell, only valid when its generation is the current one
+		struct Cell
+		{
+			U32 generation;
+			U32 first;
+		};
+
+		// Breadth-first search from the end, the first time this end is asked in the turn
+		const oe::HexGrid<I32>& getDistances(const oe::Vector2i& end, const CollisionMatrix& map, const ReservationTable& reservations);
+		void computeDistances(oe::HexGrid<I32>& distances, const oe::Vector2i& end, const CollisionMatrix& map, const ReservationTable& reservations);
+		bool isWall(const oe::Vector2i& coords, const CollisionMatrix& map, const ReservationTable& reservations) const;
+		bool canPark(const oe::Vector2i& coords, U32 time, U32 owner, const ReservationTable& reservations) const;
+
+		U32 addNode(U32 cell, U32 step, U32 parent);
+		bool hasNode(U32 cell, U32 step) const;
+
+		static U64 toKey(const oe::Vector2i& end);
+
+	private:
+		std::vector<oe::HexGrid<I32>> mDistances; // The grids are kept between turns
+		std::unordered_map<U64, U32> mDistanceSlots; // End -> index in mDistances, for this turn
+		U32 mMapVersion; // The distances are dropped if the map changes during the turn
+		std::vector<U32> mQueue;
+		oe::HexGrid<Cell> mCells;
+		std::vector<Node> mNodes; // Only the nodes reached by the current search
+		std::vector<std::pair<I32, U32>> mOpen;
+		oe::Vector2i mStart;
+		oe::Vector2i mEnd;
+		U32 mWindow;
+		U32 mGeneration;
+		Stats mStats;
+};
+
+#endif // COOPERATIVEASTAR_HPP
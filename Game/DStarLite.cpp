@@ -0,0 +1,398 @@
+#include "DStarLite.hpp"
+
+const I32 DStarLite::Infinity;
+const U32 DStarLite::InvalidIndex;
+
+DStarLite::Stats::Stats()
+	: expansions(0)
+	, changes(0)
+	, queries(0)
+	, resets(0)
+	, totalExpansions(0)
+	, nodes(0)
+{
+}
+
+DStarLite::DStarLite()
+	: mNodes()
+	, mSize()
+	, mHeap()
+	, mChanges()
+	, mStart()
+	, mGoal()
+	, mKm(0)
+	, mVersion(0)
+	, mInitialized(false)
+	, mStats()
+{
+}
+
+void DStarLite::reset()
+{
+	mInitialized = false;
+}
+
+bool DStarLite::run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& goal, const CollisionMatrix& map, U32 maxSteps)
+{
+	path.clear();
+	mStats.expansions = 0;
+	mStats.changes = 0;
+	mStats.queries++;
+
+	// The journal is read again on the next query, the goal might be free by then
+	if (start == goal || !map.getGrid().contains(start) || map.get(goal))
+	{
+		return false;
+	}
+
+	mChanges.clear();
+	if (!mInitialized || goal != mGoal || mSize != map.getSize() || !map.getChanges(mVersion, mChanges))
+	{
+		initialize(start, goal, map);
+		mStats.resets++;
+	}
+	else
+	{
+		if (start != mStart)
+		{
+			// Keys computed from the previous start stay lower bounds
+			mKm += AStar::distance(mStart, start);
+
+			// The start is always free for the planner : both cells change
+			const oe::Vector2i previous(mStart);
+			mStart = start;
+			applyChange(previous, map);
+			applyChange(start, map);
+		}
+		for (const oe::Vector2i& change : mChanges)
+		{
+			applyChange(change, map);
+		}
+		mStats.changes = mChanges.size();
+	}
+	mVersion = map.getVersion();
+
+	computeShortestPath(map);
+	mStats.totalExpansions += mStats.expansions;
+	mStats.nodes = mNodes.size();
+
+	auto itr = mNodes.find(toIndex(start));
+	if (itr == mNodes.end() || itr->second.rhs >= Infinity)
+	{
+		return false;
+	}
+	extractPath(path, map, maxSteps);
+	return !path.empty();
+}
+
+const oe::Vector2i& DStarLite::getGoal() const
+{
+	return mGoal;
+}
+
+const DStarLite::Stats& DStarLite::getStats() const
+{
+	return mStats;
+}
+
+void DStarLite::initialize(const oe::Vector2i& start, const oe::Vector2i& goal, const CollisionMatrix& map)
+{
+	mNodes.clear();
+	mSize = map.getSize();
+	mHeap.clear();
+	mKm = 0;
+	mStart = start;
+	mGoal = goal;
+
+	const U32 goalIndex = toIndex(goal);
+	Node& node = getNode(goalIndex);
+	node.rhs = 0;
+	computeKey(node, goalIndex, node.key1, node.key2);
+	heapInsert(goalIndex);
+
+	mInitialized = true;
+}
+
+void DStarLite::applyChange(const oe::Vector2i& coords, const CollisionMatrix& map)
+{
+	if (!contains(coords))
+	{
+		return;
+	}
+	// The cost of every edge around the cell has changed
+	updateVertex(toIndex(coords), map);
+	for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+	{
+		if (contains(neighbor))
+		{
+			updateVertex(toIndex(neighbor), map);
+		}
+	}
+}
+
+void DStarLite::computeShortestPath(const CollisionMatrix& map)
+{
+	const U32 startIndex = toIndex(mStart);
+	Node& start = getNode(startIndex);
+	while (!mHeap.empty())
+	{
+		const U32 current = mHeap.front();
+		Node& node = getNode(current);
+		I32 startKey1, startKey2;
+		computeKey(start, startIndex, startKey1, startKey2);
+		if (!keyLess(node.key1, node.key2, startKey1, startKey2) && start.rhs <= start.g)
+		{
+			break;
+		}
+		mStats.expansions++;
+
+		I32 key1, key2;
+		computeKey(node, current, key1, key2);
+		if (keyLess(node.key1, node.key2, key1, key2))
+		{
+			node.key1 = key1;
+			node.key2 = key2;
+			heapUpdate(current);
+			continue;
+		}
+
+		if (node.g > node.rhs)
+		{
+			node.g = node.rhs;
+			heapRemove(current);
+		}
+		else
+		{
+			node.g = Infinity;
+			updateVertex(current, map);
+		}
+
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(toCoords(current)))
+		{
+			if (contains(neighbor))
+			{
+				updateVertex(toIndex(neighbor), map);
+			}
+		}
+	}
+}
+
+void DStarLite::updateVertex(U32 index, const CollisionMatrix& map)
+{
+	const oe::Vector2i coords(toCoords(index));
+	I32 rhs = 0;
+	if (coords != mGoal)
+	{
+		rhs = Infinity;
+		if (!isBlocked(coords, map))
+		{
+			for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+			{
+				if (!isBlocked(neighbor, map))
+				{
+					const I32 g = getG(neighbor);
+					if (g < Infinity && g + 1 < rhs)
+					{
+						rhs = g + 1;
+					}
+				}
+			}
+		}
+	}
+
+	// A cell at infinity and out of the heap doesn't need a node
+	auto itr = mNodes.find(index);
+	if (itr == mNodes.end())
+	{
+		if (rhs >= Infinity)
+		{
+			return;
+		}
+		itr = mNodes.emplace(index, Node{ Infinity, Infinity, 0, 0, InvalidIndex }).first;
+	}
+	Node& node = itr->second;
+	node.rhs = rhs;
+
+	if (node.g != node.rhs)
+	{
+		computeKey(node, index, node.key1, node.key2);
+		if (node.heapPosition != InvalidIndex)
+		{
+			heapUpdate(index);
+		}
+		else
+		{
+			heapInsert(index);
+		}
+	}
+	else
+	{
+		if (node.heapPosition != InvalidIndex)
+		{
+			heapRemove(index);
+		}
+		if (node.g >= Infinity && index != toIndex(mStart))
+		{
+			mNodes.erase(itr);
+		}
+	}
+}
+
+void DStarLite::extractPath(std::list<oe::Vector2i>& path, const CollisionMatrix& map, U32 maxSteps)
+{
+	oe::Vector2i current(mStart);
+	U32 steps = static_cast<U32>(mSize.x * mSize.y);
+	while (current != mGoal && (maxSteps == 0 || path.size() < maxSteps) && steps-- > 0)
+	{
+		I32 best = Infinity;
+		oe::Vector2i next;
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(current))
+		{
+			if (!isBlocked(neighbor, map) && getG(neighbor) < best)
+			{
+				best = getG(neighbor);
+				next = neighbor;
+			}
+		}
+		if (best >= Infinity)
+		{
+			path.clear();
+			return;
+		}
+		path.push_back(next);
+		current = next;
+	}
+}
+
+DStarLite::Node& DStarLite::getNode(U32 index)
+{
+	auto itr = mNodes.find(index);
+	if (itr == mNodes.end())
+	{
+		itr = mNodes.emplace(index, Node{ Infinity, Infinity, 0, 0, InvalidIndex }).first;
+	}
+	return itr->second;
+}
+
+I32 DStarLite::getG(const oe::Vector2i& coords) const
+{
+	if (!contains(coords))
+	{
+		return Infinity;
+	}
+	auto itr = mNodes.find(toIndex(coords));
+	return (itr != mNodes.end()) ? itr->second.g : Infinity;
+}
+
+bool DStarLite::contains(const oe::Vector2i& coords) const
+{
+	return coords.x >= 0 && coords.y >= 0 && coords.x < mSize.x && coords.y < mSize.y;
+}
+
+U32 DStarLite::toIndex(const oe::Vector2i& coords) const
+{
+	return static_cast<U32>(coords.x + coords.y * mSize.x);
+}
+
+oe::Vector2i DStarLite::toCoords(U32 index) const
+{
+	return oe::Vector2i(static_cast<I32>(index) % mSize.x, static_cast<I32>(index) / mSize.x);
+}
+
+bool DStarLite::isBlocked(const oe::Vector2i& coords, const CollisionMatrix& map) const
+{
+	return coords != mStart && map.get(coords);
+}
+
+void DStarLite::computeKey(const Node& node, U32 index, I32& key1, I32& key2) const
+{
+	key2 = std::min(node.g, node.rhs);
+	key1 = (key2 < Infinity) ? key2 + AStar::distance(mStart, toCoords(index)) + mKm : Infinity;
+}
+
+bool DStarLite::keyLess(I32 a1, I32 a2, I32 b1, I32 b2)
+{
+	return a1 < b1 || (a1 == b1 && a2 < b2);
+}
+
+void DStarLite::heapInsert(U32 index)
+{
+	mNodes[index].heapPosition = mHeap.size();
+	mHeap.push_back(index);
+	heapUp(mHeap.size() - 1);
+}
+
+void DStarLite::heapRemove(U32 index)
+{
+	const U32 position = mNodes[index].heapPosition;
+	ASSERT(position != InvalidIndex);
+	const U32 last = mHeap.back();
+	mHeap.pop_back();
+	mNodes[index].heapPosition = InvalidIndex;
+	if (position < mHeap.size())
+	{
+		mHeap[position] = last;
+		mNodes[last].heapPosition = position;
+		heapUp(position);
+		heapDown(mNodes[last].heapPosition);
+	}
+}
+
+void DStarLite::heapUpdate(U32 index)
+{
+	heapUp(mNodes[index].heapPosition);
+	heapDown(mNodes[index].heapPosition);
+}
+
+void DStarLite::heapUp(U32 position)
+{
+	const U32 index = mHeap[position];
+	while (position > 0)
+	{
+		const U32 parent = (position - 1) / 2;
+		if (!heapLess(index, mHeap[parent]))
+		{
+			break;
+		}
+		mHeap[position] = mHeap[parent];
+		mNodes[mHeap[position]].heapPosition = position;
+		position = parent;
+	}
+	mHeap[position] = index;
+	mNodes[index].heapPosition = position;
+}
+
+void DStarLite::heapDown(U32 position)
+{
+	const U32 index = mHeap[position];
+	const U32 size = mHeap.size();
+	while (true)
+	{
+		U32 child = position * 2 + 1;
+		if (child >= size)
+		{
+			break;
+		}
+		if (child + 1 < size && heapLess(mHeap[child + 1], mHeap[child]))
+		{
+			child++;
+		}
+		if (!heapLess(mHeap[child], index))
+		{
+			break;
+		}
+		mHeap[position] = mHeap[child];
+		mNodes[mHeap[position]].heapPosition = position;
+		position = child;
+	}
+	mHeap[position] = index;
+	mNodes[index].heapPosition = position;
+}
+
+bool DStarLite::heapLess(U32 a, U32 b) const
+{
+	// Every node of the heap exists
+	const Node& na = mNodes.find(a)->second;
+	const Node& nb = mNodes.find(b)->second;
+	return keyLess(na.key1, na.key2, nb.key1, nb.key2);
+}
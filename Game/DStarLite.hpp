@@ -0,0 +1,89 @@
+#ifndef DSTARLITE_HPP
+#define DSTARLITE_HPP
+
+#include "Pathfinding.hpp"
+
+#include <unordered_map>
+
+// Incremental planner (D* Lite) : the search runs from the goal to the start and is kept between queries
+// While the goal stays the same, only the cells changed since the last query (read from the journal of the map) are repaired
+// One planner per moving entity, the start can be a wall (the cell of the ant)
+// Only the cells reached by the search have a node, so the memory follows the searched area and not the map
+class DStarLite
+{
+	public:
+		struct Stats
+		{
+			Stats();
+
+			U32 expansions; // Last query
+			U32 changes; // Last query
+			U32 queries;
+			U32 resets; // Queries that started a new search
+			U64 totalExpansions;
+			U32 nodes; // Cells with a node
+		};
+
+		DStarLite();
+
+		void reset();
+
+		// Same format as AStar::run, but the path only has the first maxSteps steps (all if 0)
+		bool run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& goal, const CollisionMatrix& map, U32 maxSteps = 0);
+
+		const oe::Vector2i& getGoal() const;
+		const Stats& getStats() const;
+
+	private:
+		static const I32 Infinity = 0x1FFFFFFF;
+		static const U32 InvalidIndex = 0xFFFFFFFF;
+
+		struct Node
+		{
+			I32 g;
+			I32 rhs;
+			I32 key1;
+			I32 key2;
+			U32 heapPosition;
+		};
+
+		void initialize(const oe::Vector2i& start, const oe::Vector2i& goal, const CollisionMatrix& map);
+		void applyChange(const oe::Vector2i& coords, const CollisionMatrix& map);
+		void computeShortestPath(const CollisionMatrix& map);
+		void updateVertex(U32 index, const CollisionMatrix& map);
+		void extractPath(std::list<oe::Vector2i>& path, const CollisionMatrix& map, U32 maxSteps);
+
+		// Cells without a node are at infinity
+		Node& getNode(U32 index);
+		I32 getG(const oe::Vector2i& coords) const;
+		bool contains(const oe::Vector2i& coords) const;
+		U32 toIndex(const oe::Vector2i& coords) const;
+		oe::Vector2i toCoords(U32 index) const;
+
+		bool isBlocked(const oe::Vector2i& coords, const CollisionMatrix& map) const;
+		void computeKey(const Node& node, U32 index, I32& key1, I32& key2) const;
+		static bool keyLess(I32 a1, I32 a2, I32 b1, I32 b2);
+
+		void heapInsert(U32 index);
+		void heapRemove(U32 index);
+		void heapUpdate(U32 index);
+		void heapUp(U32 position);
+		void heapDown(U32 position);
+		bool heapLess(U32 a, U32 b) const;
+
+	private:
+		std::unordered_map<U32, Node> mNodes;
+		oe::Vector2i mSize;
+		std::vector<U32> mHeap;
+		std::vector<oe::Vector2i> mChanges;
+
+		oe::Vector2i mStart;
+		oe::Vector2i mGoal;
+		I32 mKm;
+		U32 mVersion;
+		bool mInitialized;
+
+		Stats mStats;
+};
+
+#endif // DSTARLITE_HPP
@@ -0,0 +1,269 @@
+#include "FlowField.hpp"
+
+const I32 FlowField::Unreachable;
+const U32 FlowField::InvalidIndex;
+
+FlowField::FlowField()
+	: mTarget()
+	, mDistances()
+	, mNextSteps()
+	, mQueue()
+	, mValid(false)
+{
+}
+
+FlowField::FlowField(const oe::Vector2i& target)
+	: mTarget(target)
+	, mDistances()
+	, mNextSteps()
+	, mQueue()
+	, mValid(false)
+{
+}
+
+const oe::Vector2i& FlowField::getTarget() const
+{
+	return mTarget;
+}
+
+void FlowField::invalidate()
+{
+	mValid = false;
+}
+
+bool FlowField::isValid() const
+{
+	return mValid;
+}
+
+void FlowField::update(const CollisionMatrix& map)
+{
+	if (!mValid || mDistances.getSize() != map.getSize())
+	{
+		build(map);
+	}
+}
+
+void FlowField::onCollisionChanged(const oe::Vector2i& coords, bool value)
+{
+	if (!mValid || coords == mTarget || !mDistances.contains(coords))
+	{
+		return;
+	}
+	if (value)
+	{
+		// A cell of the field is now blocked : only the cells that go through it need a new path
+		const U32 index = mDistances.toIndex(coords);
+		if (mDistances[index] == Unreachable)
+		{
+			return;
+		}
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+		{
+			if (mDistances.contains(neighbor) && mNextSteps[neighbor] == index)
+			{
+				mValid = false;
+				return;
+			}
+		}
+
+		// A leaf of the field : removing it changes no other distance
+		mDistances[index] = Unreachable;
+		mNextSteps[index] = InvalidIndex;
+	}
+	else
+	{
+		// A cell next to the field is now free : the field can grow or get shorter
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+		{
+			if (mDistances.get(neighbor, Unreachable) != Unreachable)
+			{
+				mValid = false;
+				return;
+			}
+		}
+	}
+}
+
+I32 FlowField::getDistance(const oe::Vector2i& coords) const
+{
+	ASSERT(mValid);
+	if (!mDistances.contains(coords))
+	{
+		return Unreachable;
+	}
+	I32 distance = mDistances[coords];
+	if (distance == Unreachable)
+	{
+		U32 index;
+		if (getBestNeighbor(coords, index))
+		{
+			distance = mDistances[index] + 1;
+		}
+	}
+	return distance;
+}
+
+bool FlowField::isReachable(const oe::Vector2i& coords) const
+{
+	return getDistance(coords) != Unreachable;
+}
+
+bool FlowField::getNextStep(const oe::Vector2i& from, oe::Vector2i& next) const
+{
+	ASSERT(mValid);
+	if (from == mTarget || !mDistances.contains(from))
+	{
+		return false;
+	}
+	U32 index = mNextSteps[from];
+	if (index == InvalidIndex && !getBestNeighbor(from, index))
+	{
+		return false;
+	}
+	next = mDistances.toCoords(index);
+	return true;
+}
+
+bool FlowField::getPath(std::list<oe::Vector2i>& path, const oe::Vector2i& from) const
+{
+	path.clear();
+	oe::Vector2i current(from);
+	oe::Vector2i next;
+	while (getNextStep(current, next))
+	{
+		path.push_back(next);
+		current = next;
+	}
+	return !path.empty();
+}
+
+void FlowField::build(const CollisionMatrix& map)
+{
+	const oe::Vector2i& size = map.getSize();
+	if (mDistances.getSize() != size)
+	{
+		mDistances.create(size, Unreachable);
+		mNextSteps.create(size, InvalidIndex);
+	}
+	else
+	{
+		mDistances.fill(Unreachable);
+		mNextSteps.fill(InvalidIndex);
+	}
+
+	mQueue.clear();
+	if (mDistances.contains(mTarget))
+	{
+		const U32 target = mDistances.toIndex(mTarget);
+		mDistances[target] = 0;
+		mQueue.push_back(target);
+	}
+
+	for (U32 i = 0; i < mQueue.size(); i++)
+	{
+		const U32 current = mQueue[i];
+		const I32 distance = mDistances[current] + 1;
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(mDistances.toCoords(current)))
+		{
+			if (map.get(neighbor)) // Wall or outside of the map
+			{
+				continue;
+			}
+			const U32 index = mDistances.toIndex(neighbor);
+			if (mDistances[index] == Unreachable)
+			{
+				mDistances[index] = distance;
+				mNextSteps[index] = current;
+				mQueue.push_back(index);
+			}
+		}
+	}
+
+	mValid = true;
+}
+
+bool FlowField::getBestNeighbor(const oe::Vector2i& coords, U32& index) const
+{
+	bool found = false;
+	I32 best = Unreachable;
+	for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+	{
+		const I32 distance = mDistances.get(neighbor, Unreachable);
+		if (distance != Unreachable && (!found || distance < best))
+		{
+			index = mDistances.toIndex(neighbor);
+			best = distance;
+			found = true;
+		}
+	}
+	return found;
+}
+
+FlowFieldCache::FlowFieldCache()
+	: mFields()
+	, mSlots()
+{
+}
+
+void FlowFieldCache::add(const oe::Vector2i& target)
+{
+	if (mSlots.emplace(toKey(target), (U32)mFields.size()).second)
+	{
+		mFields.emplace_back(target);
+	}
+}
+
+void FlowFieldCache::remove(const oe::Vector2i& target)
+{
+	auto itr = mSlots.find(toKey(target));
+	if (itr == mSlots.end())
+	{
+		return;
+	}
+	// The last field takes the slot of the removed one
+	const U32 slot = itr->second;
+	mSlots.erase(itr);
+	if (slot + 1 < mFields.size())
+	{
+		mFields[slot] = std::move(mFields.back());
+		mSlots[toKey(mFields[slot].getTarget())] = slot;
+	}
+	mFields.pop_back();
+}
+
+bool FlowFieldCache::has(const oe::Vector2i& target) const
+{
+	return mSlots.find(toKey(target)) != mSlots.end();
+}
+
+void FlowFieldCache::clear()
+{
+	mFields.clear();
+	mSlots.clear();
+}
+
+FlowField* FlowFieldCache::get(const oe::Vector2i& target, const CollisionMatrix& map)
+{
+	auto itr = mSlots.find(toKey(target));
+	if (itr == mSlots.end())
+	{
+		return nullptr;
+	}
+	FlowField& field = mFields[itr->second];
+	field.update(map);
+	return &field;
+}
+
+void FlowFieldCache::onCollisionChanged(const oe::Vector2i& coords, bool value)
+{
+	for (FlowField& field : mFields)
+	{
+		field.onCollisionChanged(coords, value);
+	}
+}
+
+U64 FlowFieldCache::toKey(const oe::Vector2i& target)
+{
+	return (static_cast<U64>(static_cast<U32>(target.x)) << 32) | static_cast<U64>(static_cast<U32>(target.y));
+}
@@ -0,0 +1,73 @@
+#ifndef FLOWFIELD_HPP
+#define FLOWFIELD_HPP
+
+#include "Pathfinding.hpp"
+
+#include <unordered_map>
+
+// Distance to a target from every cell of the map, with the direction to follow
+// Built with one breadth-first search from the target, the target itself is always a valid end even if it is a wall
+class FlowField
+{
+	public:
+		static const I32 Unreachable = -1;
+
+		FlowField();
+		FlowField(const oe::Vector2i& target);
+
+		const oe::Vector2i& getTarget() const;
+
+		void invalidate();
+		bool isValid() const;
+		void update(const CollisionMatrix& map);
+
+		// Invalidate the field only if the cell touches the area reached by the field
+		// A blocked cell that no other cell goes through is removed without a rebuild
+		void onCollisionChanged(const oe::Vector2i& coords, bool value);
+
+		// The start cell can be a wall (the cell of the ant), then its neighbors are used
+		I32 getDistance(const oe::Vector2i& coords) const;
+		bool isReachable(const oe::Vector2i& coords) const;
+		bool getNextStep(const oe::Vector2i& from, oe::Vector2i& next) const;
+		bool getPath(std::list<oe::Vector2i>& path, const oe::Vector2i& from) const; // Same format as AStar::run
+
+	private:
+		void build(const CollisionMatrix& map);
+		bool getBestNeighbor(const oe::Vector2i& coords, U32& index) const;
+
+	private:
+		static const U32 InvalidIndex = 0xFFFFFFFF;
+
+		oe::Vector2i mTarget;
+		oe::HexGrid<I32> mDistances;
+		oe::HexGrid<U32> mNextSteps;
+		std::vector<U32> mQueue;
+		bool mValid;
+};
+
+// One flow field per registered target, rebuilt when needed
+// The fields are found by their target without scanning the others
+class FlowFieldCache
+{
+	public:
+		FlowFieldCache();
+
+		void add(const oe::Vector2i& target);
+		void remove(const oe::Vector2i& target);
+		bool has(const oe::Vector2i& target) const;
+		void clear();
+
+		// Returns nullptr if there is no field for this target
+		FlowField* get(const oe::Vector2i& target, const CollisionMatrix& map);
+
+		void onCollisionChanged(const oe::Vector2i& coords, bool value);
+
+	private:
+		static U64 toKey(const oe::Vector2i& target);
+
+	private:
+		std::vector<FlowField> mFields;
+		std::unordered_map<U64, U32> mSlots; // Target -> index in mFields
+};
+
+#endif // FLOWFIELD_HPP
@@ -10,6 +10,8 @@
 #define WINSIZEX 800
 #define WINSIZEY 600
 #define WINTITLE "Arthropoda"
+#define UPDATERATE 60.f // Simulation steps per second, the same for every machine
+#define RENDERRATE 0.f // Frames per second, 0 : as fast as possible
 
 #define MAPSIZEX 30
 #define MAPSIZEY 30
@@ -17,6 +19,13 @@
 #define MAPTILESIZEY 69
 #define MAPHEXSIDE 37
 
+#define HPACLUSTERSIZE 16
+#define HPAMINMAPSIZE 64 // Smaller maps use AStar only
+#define DSTARLITEPATH false // Each ant keeps an incremental planner (D* Lite) instead of using HPAStar or AStar
+#define DSTARLITEJOURNAL 16 // Changed cells kept for each ant by the collision journal : a turn of moves (2 per step)
+#define AICOOPERATIVE false // The AI plans its whole turn at once (see AI::setCooperative)
+#define HEADLESSMAXTURNS 500 // Headless matches still running after this turn are a draw
+
 #define TILE_NONE 1
 #define TILE_GRID 2
 #define TILE_GROUND 3
@@ -18,7 +18,10 @@ GameMap::GameMap(oe::World& world)
 	setStaggerIndex(oe::MapUtility::Odd);
 	setHexSideLength(MAPHEXSIDE);
 
-	mCursor.setTexture(GameSingleton::tileset.getTexture());
+	if (!world.getApplication().isHeadless())
+	{
+		mCursor.setTexture(GameSingleton::tileset.getTexture());
+	}
 	mCursor.setTextureRect(sf::IntRect(0, 0, 0, 0));
 	mCursor.setVisible(false);
 
@@ -6,6 +6,8 @@
 
 class GameMap : public oe::Map
 {
+	OeEntity(GameMap, oe::Map)
+
 	public:
 		GameMap(oe::World& world);
 
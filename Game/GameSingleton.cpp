@@ -1,45 +1,82 @@
 #include "GameSingleton.hpp"
 
 #include "GameConfig.hpp" // Used to load the tileset
+#include "Ant.hpp"
 
 oe::Tileset GameSingleton::tileset;
 GameMap* GameSingleton::map;
 CollisionMatrix GameSingleton::collisions;
+CollisionMatrix GameSingleton::walls;
+ConnectivityIndex GameSingleton::connectivity;
+HPAStar GameSingleton::hierarchy;
+PathRequestQueue GameSingleton::pathRequests;
+FlowFieldCache GameSingleton::flowFields;
 oe::ResourceId GameSingleton::sansationFont;
 oe::ResourceId GameSingleton::movementSound;
 oe::ResourceId GameSingleton::actionSound;
 oe::ResourceId GameSingleton::attackSound;
 oe::ResourceId GameSingleton::antTexture;
 oe::ResourceId GameSingleton::objectsTexture;
+OccupancyIndex GameSingleton::occupancy;
 oe::EntityList GameSingleton::resources;
-oe::EntityHandle GameSingleton::anthill;
+oe::TypedHandle<Anthill> GameSingleton::anthill;
 oe::EntityList GameSingleton::ants;
-oe::EntityHandle GameSingleton::aiAnthill;
+oe::TypedHandle<Anthill> GameSingleton::aiAnthill;
 oe::EntityList GameSingleton::aiAnts;
 bool GameSingleton::win;
+bool GameSingleton::cooperative = AICOOPERATIVE;
 
-void GameSingleton::loadTileset()
+void GameSingleton::loadTileset(bool loadTexture)
 {
 	tileset.setImageSource(TILESETSOURCE);
 	tileset.setTileSize(oe::Vector2i(TILESETSIZEX, TILESETSIZEY));
 	tileset.setTileCount(TILESETCOUNT);
 	tileset.setColumns(TILESETCOLUMNS);
-	tileset.getTexture(); // Used to load the texture now
+	if (loadTexture)
+	{
+		tileset.getTexture(); // Used to load the texture now
+	}
 }
 
 void GameSingleton::initCollisions(I32 sizeX, I32 sizeY)
 {
 	collisions.create(sizeX, sizeY);
+	walls.create(sizeX, sizeY);
+	occupancy.create(oe::Vector2i(sizeX, sizeY));
+	connectivity.build(walls);
+	AStar::setConnectivity(&connectivity);
+	hierarchy.setClusterSize(HPACLUSTERSIZE);
+	hierarchy.setConnectivity(&connectivity);
 }
 
 void GameSingleton::setCollision(const oe::Vector2i& coords, bool value)
 {
-	collisions.set(coords, value);
+	if (!walls.getGrid().contains(coords) || walls.get(coords) == value)
+	{
+		return;
+	}
+	walls.set(coords, value);
+	connectivity.onCollisionChanged(coords, value, walls);
+	flowFields.onCollisionChanged(coords, value);
+	hierarchy.onCollisionChanged(coords);
+
+	// An ant can stand on a cell that is not a wall anymore
+	collisions.set(coords, value || occupancy.get<Ant>(coords) != nullptr);
+}
+
+void GameSingleton::setUnitCollision(const oe::Vector2i& coords, bool value)
+{
+	if (!collisions.getGrid().contains(coords))
+	{
+		return;
+	}
+	collisions.set(coords, value || walls.get(coords));
 }
 
 bool GameSingleton::isCollision(const oe::Vector2i& coords)
 {
-	if (coords.x < 0 || coords.y < 0 || coords.x >= MAPSIZEX || coords.y >= MAPSIZEY)
+	const oe::Vector2i& size = collisions.getSize();
+	if (coords.x < 0 || coords.y < 0 || coords.x >= size.x || coords.y >= size.y)
 	{
 		return false;
 	}
@@ -56,6 +93,22 @@ bool GameSingleton::isCollision(I32 x, I32 y)
 	return isCollision(oe::Vector2i(x, y));
 }
 
+bool GameSingleton::canReach(const oe::Vector2i& start, const oe::Vector2i& end)
+{
+	return connectivity.canReach(start, end);
+}
+
+bool GameSingleton::useHierarchy()
+{
+	const oe::Vector2i& size = collisions.getSize();
+	return size.x >= HPAMINMAPSIZE || size.y >= HPAMINMAPSIZE;
+}
+
+FlowField* GameSingleton::getFlowField(const oe::Vector2i& target)
+{
+	return flowFields.get(target, walls);
+}
+
 Resource* GameSingleton::getResource(I32 x, I32 y)
 {
 	return getResource(oe::Vector2i(x, y));
@@ -63,15 +116,7 @@ Resource* GameSingleton::getResource(I32 x, I32 y)
 
 Resource* GameSingleton::getResource(const oe::Vector2i& coords)
 {
-	for (auto itr = resources.begin(); itr != resources.end(); ++itr)
-	{
-		Resource* r = itr->getAs<Resource>();
-		if (r != nullptr && r->getCoords() == coords)
-		{
-			return r;
-		}
-	}
-	return nullptr;
+	return occupancy.get<Resource>(coords);
 }
 
 bool GameSingleton::hasResource(I32 x, I32 y)
@@ -87,7 +132,7 @@ bool GameSingleton::hasResource(const oe::Vector2i& coords)
 Anthill& GameSingleton::getAnthill()
 {
 	ASSERT(anthill.isValid());
-	Anthill* anthillPtr = anthill.getAs<Anthill>();
+	Anthill* anthillPtr = anthill.get();
 	ASSERT(anthillPtr != nullptr);
 	return *anthillPtr;
 }
@@ -113,34 +158,19 @@ Ant* GameSingleton::getAnt(I32 x, I32 y)
 
 Ant* GameSingleton::getAnt(const oe::Vector2i& coords)
 {
-	for (const oe::EntityHandle& e : ants)
-	{
-		Ant* ant = e.getAs<Ant>();
-		if (ant != nullptr && ant->getCoords() == coords)
-		{
-			return ant;
-		}
-	}
-	return nullptr;
+	return occupancy.get<Ant>(coords, 1);
 }
 
 oe::EntityHandle GameSingleton::getAntHandle(const oe::Vector2i& coords)
 {
-	for (const oe::EntityHandle& e : ants)
-	{
-		Ant* ant = e.getAs<Ant>();
-		if (ant != nullptr && ant->getCoords() == coords)
-		{
-			return e;
-		}
-	}
-	return oe::EntityHandle();
+	Ant* ant = occupancy.get<Ant>(coords, 1);
+	return (ant != nullptr) ? ant->getHandle() : oe::EntityHandle();
 }
 
 Anthill& GameSingleton::getAIAnthill()
 {
 	ASSERT(aiAnthill.isValid());
-	Anthill* anthillPtr = aiAnthill.getAs<Anthill>();
+	Anthill* anthillPtr = aiAnthill.get();
 	ASSERT(anthillPtr != nullptr);
 	return *anthillPtr;
 }
@@ -166,28 +196,30 @@ Ant* GameSingleton::getAIAnt(I32 x, I32 y)
 
 Ant* GameSingleton::getAIAnt(const oe::Vector2i& coords)
 {
-	for (const oe::EntityHandle& e : aiAnts)
-	{
-		Ant* ant = e.getAs<Ant>();
-		if (ant != nullptr && ant->getCoords() == coords)
-		{
-			return ant;
-		}
-	}
-	return nullptr;
+	return occupancy.get<Ant>(coords, 2);
 }
 
 oe::EntityHandle GameSingleton::getAIAntHandle(const oe::Vector2i & coords)
 {
-	for (const oe::EntityHandle& e : aiAnts)
-	{
-		Ant* ant = e.getAs<Ant>();
-		if (ant != nullptr && ant->getCoords() == coords)
-		{
-			return e;
-		}
-	}
-	return oe::EntityHandle();
+	Ant* ant = occupancy.get<Ant>(coords, 2);
+	return (ant != nullptr) ? ant->getHandle() : oe::EntityHandle();
+}
+
+const oe::EntityHandle& GameSingleton::getAnthillHandle(U32 player)
+{
+	ASSERT(player == 1 || player == 2);
+	return (player == 1) ? anthill.getHandle() : aiAnthill.getHandle();
+}
+
+Anthill& GameSingleton::getAnthill(U32 player)
+{
+	return (player == 1) ? getAnthill() : getAIAnthill();
+}
+
+oe::EntityList& GameSingleton::getAnts(U32 player)
+{
+	ASSERT(player == 1 || player == 2);
+	return (player == 1) ? ants : aiAnts;
 }
 
 void GameSingleton::update()
@@ -201,6 +233,14 @@ void GameSingleton::clear()
 {
 	map = nullptr;
 	collisions.clear();
+	walls.clear();
+	occupancy.clear();
+	connectivity.clear();
+	AStar::setConnectivity(nullptr);
+	hierarchy.invalidate();
+	hierarchy.setConnectivity(nullptr);
+	pathRequests.clear();
+	flowFields.clear();
 	resources.clear();
 	anthill.invalidate();
 	aiAnthill.invalidate();
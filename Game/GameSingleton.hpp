@@ -8,6 +8,11 @@
 #include "GameMap.hpp"
 #include "Ant.hpp"
 #include "Anthill.hpp"
+#include "Connectivity.hpp"
+#include "FlowField.hpp"
+#include "HPAStar.hpp"
+#include "OccupancyIndex.hpp"
+#include "PathRequestQueue.hpp"
 #include "Pathfinding.hpp"
 #include "Resource.hpp"
 
@@ -16,7 +21,7 @@ class GameSingleton
 	public:
 		// Tileset
 		static oe::Tileset tileset;
-		static void loadTileset();
+		static void loadTileset(bool loadTexture = true); // No texture in headless mode
 
 		// Fonts
 		static oe::ResourceId sansationFont;
@@ -33,7 +38,7 @@ class GameSingleton
 		// Map
 		static GameMap* map;
 
-		// Collisions
+		// Collisions : walls (terrain, anthills) and the cells of the ants
 		static CollisionMatrix collisions;
 		static void initCollisions(I32 sizeX, I32 sizeY);
 		static void setCollision(const oe::Vector2i& coords, bool value);
@@ -41,6 +46,29 @@ class GameSingleton
 		static void setCollision(I32 x, I32 y, bool value);
 		static bool isCollision(I32 x, I32 y);
 
+		// Walls only : the ants move at each step, the flow fields ignore them
+		static CollisionMatrix walls;
+		static void setUnitCollision(const oe::Vector2i& coords, bool value);
+
+		// Connected regions of the walls, used by AStar to reject unreachable ends
+		// Built from the static terrain only : the ants in collisions are not taken into account
+		static ConnectivityIndex connectivity;
+		static bool canReach(const oe::Vector2i& start, const oe::Vector2i& end);
+
+		// Hierarchical pathfinding, used on big maps, built from the walls only
+		static HPAStar hierarchy;
+		static bool useHierarchy();
+
+		// Paths solved by the workers, collected at the beginning of each frame
+		static PathRequestQueue pathRequests;
+
+		// Flow fields : one for each anthill and resource
+		static FlowFieldCache flowFields;
+		static FlowField* getFlowField(const oe::Vector2i& target);
+
+		// Map entities by cell : ants, anthills and resources
+		static OccupancyIndex occupancy;
+
 		// Game Resources
 		static oe::EntityList resources;
 		static Resource* getResource(I32 x, I32 y);
@@ -49,7 +77,7 @@ class GameSingleton
 		static bool hasResource(const oe::Vector2i& coords);
 
 		// Player 1 : Player
-		static oe::EntityHandle anthill;
+		static oe::TypedHandle<Anthill> anthill;
 		static Anthill& getAnthill();
 		static oe::EntityList ants;
 		static Ant* getAnt(U32 index);
@@ -58,7 +86,7 @@ class GameSingleton
 		static oe::EntityHandle getAntHandle(const oe::Vector2i& coords);
 
 		// Player 2 : AI
-		static oe::EntityHandle aiAnthill;
+		static oe::TypedHandle<Anthill> aiAnthill;
 		static Anthill& getAIAnthill();
 		static oe::EntityList aiAnts;
 		static Ant* getAIAnt(U32 index);
@@ -66,12 +94,18 @@ class GameSingleton
 		static Ant* getAIAnt(const oe::Vector2i& coords);
 		static oe::EntityHandle getAIAntHandle(const oe::Vector2i& coords);
 
+		// Player 1 or 2
+		static const oe::EntityHandle& getAnthillHandle(U32 player);
+		static Anthill& getAnthill(U32 player);
+		static oe::EntityList& getAnts(U32 player);
+
 		// Update all lists
 		static void update();
 		// Clear the singleton before a new game
 		static void clear();
 
 		static bool win;
+		static bool cooperative; // The AIs plan their whole turn at once (see AI::setCooperative)
 };
 
 #endif // GAMESINGLETON_HPP
@@ -7,15 +7,20 @@
 GameState::GameState(oe::StateManager& manager)
 	: oe::State(manager)
 	, mWorld(manager.getApplication())
+	, mHeadless(manager.getApplication().isHeadless())
 {
 	GameSingleton::clear();
+	GameSingleton::pathRequests.start(manager.getApplication().getJobSystem());
 
 	mTurnNumber = 0;
 	mWorld.getRenderSystem().setBackgroundColor(oe::Color::DarkGray);
 
 	// Load resources
-	mGameMaskTexture.loadFromFile("Assets/gamemask.png");
-	mGameHudTexture.loadFromFile("Assets/gamehud.png");
+	if (!mHeadless)
+	{
+		mGameMaskTexture.loadFromFile("Assets/gamemask.png");
+		mGameHudTexture.loadFromFile("Assets/gamehud.png");
+	}
 
 	// HUD
 	mGameMask.setTexture(mGameMaskTexture);
@@ -42,22 +47,30 @@ GameState::GameState(oe::StateManager& manager)
 	// Init player 1 : Player
 	mPlayer1Anthill.set(6, 6);
 	GameSingleton::anthill = mWorld.createEntity<Anthill>();
-	Anthill* anthill = GameSingleton::anthill.getAs<Anthill>();
+	Anthill* anthill = GameSingleton::anthill.get();
 	anthill->setCoords(mPlayer1Anthill);
 	anthill->setPlayer(1);
 	GameSingleton::setCollision(mPlayer1Anthill, true);
+	GameSingleton::flowFields.add(mPlayer1Anthill);
 
 	// Init player 2 : AI
 	mPlayer2Anthill.set(23, 23);
 	GameSingleton::aiAnthill = mWorld.createEntity<Anthill>();
-	anthill = GameSingleton::aiAnthill.getAs<Anthill>();
+	anthill = GameSingleton::aiAnthill.get();
 	anthill->setCoords(mPlayer2Anthill);
 	anthill->setPlayer(2);
 	GameSingleton::setCollision(mPlayer2Anthill, true);
+	GameSingleton::flowFields.add(mPlayer2Anthill);
 
 	// Init map & AI
 	initMap();
 	mAi.init();
+	mAi.setCooperative(GameSingleton::cooperative);
+	if (mHeadless)
+	{
+		mPlayerAi.init(1);
+		mPlayerAi.setCooperative(GameSingleton::cooperative);
+	}
 
 	// Start the game
 	mCurrentPlayer = 2;
@@ -65,6 +78,11 @@ GameState::GameState(oe::StateManager& manager)
 	passTurn(); // Pass to player 1 and do the announce it
 }
 
+GameState::~GameState()
+{
+	GameSingleton::pathRequests.stop();
+}
+
 bool GameState::handleEvent(const sf::Event& event)
 {
 	moveView(event);
@@ -111,23 +129,29 @@ bool GameState::handleEvent(const sf::Event& event)
 
 bool GameState::update(oe::Time dt)
 {
+	// Paths requested during the previous frame
+	GameSingleton::pathRequests.collect();
+
 	mWorld.update(dt);
 
 	GameSingleton::update();
 
-	moveView(dt);
+	if (!mHeadless)
+	{
+		moveView(dt);
+	}
 
 	if (GameSingleton::getAnthill().getLife() == 0)
 	{
-		GameSingleton::win = false;
-		popState();
-		pushState<PostState>();
+		endGame(2);
 	}
-	if (GameSingleton::getAIAnthill().getLife() == 0)
+	else if (GameSingleton::getAIAnthill().getLife() == 0)
 	{
-		GameSingleton::win = true;
-		popState();
-		pushState<PostState>();
+		endGame(1);
+	}
+	else if (mHeadless && mTurnNumber > HEADLESSMAXTURNS)
+	{
+		endGame(0);
 	}
 
 	if (!GameSingleton::map->isOverlayValid())
@@ -137,7 +161,15 @@ bool GameState::update(oe::Time dt)
 
 	Anthill& anthill = GameSingleton::getAnthill();
 
-	if (mCurrentPlayer == 1)
+	if (mCurrentPlayer == 1 && mHeadless)
+	{
+		mPlayerAi.think(dt);
+		if (mPlayerAi.isTurnOver())
+		{
+			passTurn();
+		}
+	}
+	else if (mCurrentPlayer == 1)
 	{
 		GameSingleton::map->setCursorCoords(getMouseCoords(), mCurrentPlayer);
 		mButton1.setTextureRect(sf::IntRect(0, 60 * ((anthill.canSpawn(Ant::Scout)) ? 0 : 1), 75, 60));
@@ -190,6 +222,9 @@ bool GameState::update(oe::Time dt)
 		}
 	}
 
+	// Solved while the frame is rendered
+	GameSingleton::pathRequests.dispatch(GameSingleton::collisions, &GameSingleton::connectivity);
+
 	return false;
 }
 
@@ -381,7 +416,9 @@ void GameState::initMap()
 					{
 						res->setCoords(c);
 						GameSingleton::resources.insert(r);
+						GameSingleton::flowFields.add(c);
 						mAi.addResource(c);
+						mPlayerAi.addResource(c);
 					}
 				}
 			}
@@ -478,6 +515,11 @@ void GameState::passTurn()
 			if (ant != nullptr)
 			{
 				ant->reset();
+				if (mHeadless)
+				{
+					ant->resetDest();
+					ant->invalidateTarget();
+				}
 			}
 		}
 		mCurrentPlayer = 2;
@@ -505,6 +547,10 @@ void GameState::passTurn()
 		}
 		mCurrentPlayer = 1;
 		mTurnNumber++;
+		if (mHeadless)
+		{
+			mPlayerAi.startTurn();
+		}
 	}
 	mButtonTurn.setTextureRect(sf::IntRect(225, (mCurrentPlayer == 1) ? 0 : 60, 60, 60));
 	mTurnReady = false;
@@ -533,3 +579,18 @@ void GameState::switchToNextAnt()
 		mWorld.getRenderSystem().getView().setCenter(mSelectedAnt->getPosition() + offset);
 	}
 }
+
+void GameState::endGame(U32 winner)
+{
+	GameSingleton::win = (winner == 1);
+	popState();
+	if (mHeadless)
+	{
+		// One line per match, to compare the results of a batch
+		oe::info("Match over : winner " + oe::toString(winner) + ", turn " + oe::toString(mTurnNumber));
+	}
+	else
+	{
+		pushState<PostState>();
+	}
+}
@@ -11,6 +11,7 @@ class GameState : public oe::State
 {
 	public:
 		GameState(oe::StateManager& manager);
+		~GameState();
 
 		bool handleEvent(const sf::Event& event);
 		bool update(oe::Time dt);
@@ -31,12 +32,15 @@ class GameState : public oe::State
 		void selectAnt();
 		void passTurn();
 		void switchToNextAnt();
+		void endGame(U32 winner);
 
 	private:
 		oe::World mWorld;
 		oe::Clock mClock;
 
 		AI mAi;
+		AI mPlayerAi; // Plays for player 1 in headless mode
+		bool mHeadless;
 
 		U32 mTurnNumber;
 		U32 mCurrentPlayer;
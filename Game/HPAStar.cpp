@@ -0,0 +1,640 @@
+#include "HPAStar.hpp"
+#include "Connectivity.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+
+// Clusters touched by the cells of the last row/column of a cluster : right, bottom left, bottom, bottom right
+const I32 BorderDirections[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+} // namespace
+
+const U32 HPAStar::InvalidIndex;
+
+HPAStar::Stats::Stats()
+	: abstractExpansions(0)
+	, time(oe::Time::Zero)
+	, queries(0)
+	, flatQueries(0)
+	, rebuiltClusters(0)
+	, nodes(0)
+{
+}
+
+HPAStar::HPAStar(I32 clusterSize)
+	: mClusterSize(2)
+	, mClusterCount()
+	, mMapSize()
+	, mBuilt(false)
+	, mClusters()
+	, mDirtyClusters()
+	, mBorders()
+	, mNodes()
+	, mFreeNodes()
+	, mCellNodes()
+	, mUpdateBorders()
+	, mUpdateClusters()
+	, mBorderMarks()
+	, mClusterMarks()
+	, mPairs()
+	, mClusterMin()
+	, mClusterMax()
+	, mClusterDistances()
+	, mClusterParents()
+	, mClusterQueue()
+	, mStartEdges()
+	, mEndEdges()
+	, mSearchNodes()
+	, mOpen()
+	, mAbstractPath()
+	, mStart()
+	, mEnd()
+	, mGeneration(0)
+	, mFlatSearch()
+	, mConnectivity(nullptr)
+	, mStats()
+{
+	setClusterSize(clusterSize);
+}
+
+void HPAStar::setClusterSize(I32 clusterSize)
+{
+	mClusterSize = std::max(clusterSize, 2);
+	mBuilt = false;
+}
+
+I32 HPAStar::getClusterSize() const
+{
+	return mClusterSize;
+}
+
+void HPAStar::onCollisionChanged(const oe::Vector2i& coords)
+{
+	if (!mBuilt || !mCellNodes.contains(coords))
+	{
+		return;
+	}
+	const U32 cluster = getCluster(coords);
+	if (!mClusters[cluster].dirty)
+	{
+		mClusters[cluster].dirty = true;
+		mDirtyClusters.push_back(cluster);
+	}
+}
+
+void HPAStar::invalidate()
+{
+	mBuilt = false;
+}
+
+void HPAStar::setConnectivity(const ConnectivityIndex* connectivity)
+{
+	mConnectivity = connectivity;
+	mFlatSearch.setConnectivity(connectivity);
+}
+
+bool HPAStar::run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, U32 maxSteps)
+{
+	oe::Clock clock;
+	bool found = false;
+	path.clear();
+	mStats.abstractExpansions = 0;
+
+	// The start can be a wall (the cell of the ant), the end can't
+	if (start != end && map.getGrid().contains(start) && !map.get(end)
+		&& (mConnectivity == nullptr || mConnectivity->canReach(start, end)))
+	{
+		update(map);
+		if (getCluster(start) == getCluster(end) || AStar::distance(start, end) <= mClusterSize)
+		{
+			found = mFlatSearch.run(path, start, end, map);
+			mStats.flatQueries++;
+		}
+		else if (searchAbstract(start, end, map))
+		{
+			refine(path, start, end, map, maxSteps);
+			found = true;
+		}
+	}
+
+	mStats.time = clock.getElapsedTime();
+	mStats.queries++;
+	mStats.nodes = mNodes.size() - mFreeNodes.size();
+	return found;
+}
+
+const HPAStar::Stats& HPAStar::getStats() const
+{
+	return mStats;
+}
+
+void HPAStar::resetStats()
+{
+	mStats = Stats();
+}
+
+void HPAStar::update(const CollisionMatrix& map)
+{
+	if (!mBuilt || mMapSize != map.getSize())
+	{
+		build(map);
+	}
+	if (mDirtyClusters.empty())
+	{
+		return;
+	}
+
+	// Every border of a dirty cluster is scanned again, and the clusters on both sides get new edges
+	mUpdateBorders.clear();
+	mUpdateClusters.clear();
+	for (U32 cluster : mDirtyClusters)
+	{
+		mClusters[cluster].dirty = false;
+		for (U32 direction = 0; direction < 4; direction++)
+		{
+			for (U32 forward = 0; forward < 2; forward++)
+			{
+				U32 border;
+				if (!getBorder(cluster, direction, forward == 1, border) || mBorderMarks[border])
+				{
+					continue;
+				}
+				mBorderMarks[border] = true;
+				mUpdateBorders.push_back(border);
+
+				const U32 sides[2] = { border / 4, getBorderSecondCluster(border) };
+				for (U32 side : sides)
+				{
+					if (!mClusterMarks[side])
+					{
+						mClusterMarks[side] = true;
+						mUpdateClusters.push_back(side);
+					}
+				}
+			}
+		}
+		if (!mClusterMarks[cluster]) // No border on a map with only one cluster
+		{
+			mClusterMarks[cluster] = true;
+			mUpdateClusters.push_back(cluster);
+		}
+	}
+	mStats.rebuiltClusters += mDirtyClusters.size();
+	mDirtyClusters.clear();
+
+	for (U32 border : mUpdateBorders)
+	{
+		clearBorder(border);
+	}
+	for (U32 border : mUpdateBorders)
+	{
+		scanBorder(border, map);
+		mBorderMarks[border] = false;
+	}
+	for (U32 cluster : mUpdateClusters)
+	{
+		removeUnusedNodes(cluster);
+		computeEdges(cluster, map);
+		mClusterMarks[cluster] = false;
+	}
+}
+
+void HPAStar::build(const CollisionMatrix& map)
+{
+	mMapSize = map.getSize();
+	mClusterCount.set((mMapSize.x + mClusterSize - 1) / mClusterSize, (mMapSize.y + mClusterSize - 1) / mClusterSize);
+	const U32 clusterCount = mClusterCount.x * mClusterCount.y;
+
+	mClusters.clear();
+	mClusters.resize(clusterCount);
+	mDirtyClusters.clear();
+	for (U32 i = 0; i < clusterCount; i++)
+	{
+		mClusters[i].dirty = true;
+		mDirtyClusters.push_back(i);
+	}
+	mBorders.clear();
+	mBorders.resize(clusterCount * 4);
+	mNodes.clear();
+	mFreeNodes.clear();
+	mCellNodes.create(mMapSize, InvalidIndex);
+
+	mBorderMarks.assign(clusterCount * 4, false);
+	mClusterMarks.assign(clusterCount, false);
+	mClusterDistances.assign(mClusterSize * mClusterSize, -1);
+	mClusterParents.assign(mClusterSize * mClusterSize, InvalidIndex);
+
+	mBuilt = true;
+}
+
+U32 HPAStar::getCluster(const oe::Vector2i& coords) const
+{
+	return (U32)(coords.x / mClusterSize + (coords.y / mClusterSize) * mClusterCount.x);
+}
+
+void HPAStar::getClusterBounds(U32 cluster, oe::Vector2i& min, oe::Vector2i& max) const
+{
+	min.set((cluster % mClusterCount.x) * mClusterSize, (cluster / mClusterCount.x) * mClusterSize);
+	max.set(std::min(min.x + mClusterSize, mMapSize.x), std::min(min.y + mClusterSize, mMapSize.y));
+}
+
+bool HPAStar::getBorder(U32 cluster, U32 direction, bool forward, U32& border) const
+{
+	const I32 dx = BorderDirections[direction][0];
+	const I32 dy = BorderDirections[direction][1];
+	I32 x = cluster % mClusterCount.x;
+	I32 y = cluster / mClusterCount.x;
+	if (!forward)
+	{
+		x -= dx;
+		y -= dy;
+	}
+	const I32 sx = x + dx;
+	const I32 sy = y + dy;
+	if (x < 0 || y < 0 || x >= mClusterCount.x || y >= mClusterCount.y || sx < 0 || sy < 0 || sx >= mClusterCount.x || sy >= mClusterCount.y)
+	{
+		return false;
+	}
+	border = (U32)(x + y * mClusterCount.x) * 4 + direction;
+	return true;
+}
+
+U32 HPAStar::getBorderSecondCluster(U32 border) const
+{
+	const U32 cluster = border / 4;
+	const U32 direction = border % 4;
+	return cluster + BorderDirections[direction][0] + BorderDirections[direction][1] * mClusterCount.x;
+}
+
+void HPAStar::clearBorder(U32 border)
+{
+	for (const Transition& transition : mBorders[border])
+	{
+		const U32 nodes[2] = { transition.first, transition.second };
+		for (U32 i = 0; i < 2; i++)
+		{
+			Node& node = mNodes[nodes[i]];
+			auto itr = std::find(node.links.begin(), node.links.end(), nodes[1 - i]);
+			if (itr != node.links.end())
+			{
+				node.links.erase(itr);
+			}
+			node.references--;
+		}
+	}
+	mBorders[border].clear();
+}
+
+void HPAStar::scanBorder(U32 border, const CollisionMatrix& map)
+{
+	const U32 cluster = border / 4;
+	const U32 second = getBorderSecondCluster(border);
+	const bool right = (border % 4) == 0;
+	oe::Vector2i min, max;
+	getClusterBounds(cluster, min, max);
+
+	// Every free pair of cells across the border, in the order of the border
+	mPairs.clear();
+	const I32 length = (right) ? max.y - min.y : max.x - min.x;
+	for (I32 i = 0; i < length; i++)
+	{
+		const oe::Vector2i cell = (right) ? oe::Vector2i(max.x - 1, min.y + i) : oe::Vector2i(min.x + i, max.y - 1);
+		if (map.get(cell))
+		{
+			continue;
+		}
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(cell))
+		{
+			if (!map.get(neighbor) && getCluster(neighbor) == second)
+			{
+				mPairs.emplace_back(cell, neighbor);
+			}
+		}
+	}
+
+	// One transition in the middle of each group of adjacent pairs
+	U32 i = 0;
+	while (i < mPairs.size())
+	{
+		U32 j = i + 1;
+		while (j < mPairs.size() && AStar::distance(mPairs[j].first, mPairs[j - 1].first) <= 1 && AStar::distance(mPairs[j].second, mPairs[j - 1].second) <= 1)
+		{
+			j++;
+		}
+		const std::pair<oe::Vector2i, oe::Vector2i>& pair = mPairs[(i + j - 1) / 2];
+		Transition transition;
+		transition.first = getNode(pair.first, cluster);
+		transition.second = getNode(pair.second, second);
+		mNodes[transition.first].references++;
+		mNodes[transition.first].links.push_back(transition.second);
+		mNodes[transition.second].references++;
+		mNodes[transition.second].links.push_back(transition.first);
+		mBorders[border].push_back(transition);
+		i = j;
+	}
+}
+
+U32 HPAStar::getNode(const oe::Vector2i& coords, U32 cluster)
+{
+	U32 index = mCellNodes[coords];
+	if (index != InvalidIndex)
+	{
+		return index;
+	}
+	if (!mFreeNodes.empty())
+	{
+		index = mFreeNodes.back();
+		mFreeNodes.pop_back();
+	}
+	else
+	{
+		index = mNodes.size();
+		mNodes.emplace_back();
+	}
+	Node& node = mNodes[index];
+	node.coords = coords;
+	node.cluster = cluster;
+	node.references = 0;
+	node.edges.clear();
+	node.links.clear();
+	mCellNodes[coords] = index;
+	mClusters[cluster].nodes.push_back(index);
+	return index;
+}
+
+void HPAStar::removeUnusedNodes(U32 cluster)
+{
+	std::vector<U32>& nodes = mClusters[cluster].nodes;
+	U32 i = 0;
+	while (i < nodes.size())
+	{
+		Node& node = mNodes[nodes[i]];
+		if (node.references == 0)
+		{
+			mCellNodes[node.coords] = InvalidIndex;
+			node.cluster = InvalidIndex;
+			node.edges.clear();
+			node.links.clear();
+			mFreeNodes.push_back(nodes[i]);
+			nodes[i] = nodes.back();
+			nodes.pop_back();
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+void HPAStar::computeEdges(U32 cluster, const CollisionMatrix& map)
+{
+	const std::vector<U32>& nodes = mClusters[cluster].nodes;
+	for (U32 index : nodes)
+	{
+		Node& node = mNodes[index];
+		node.edges.clear();
+		searchCluster(node.coords, cluster, map);
+		for (U32 other : nodes)
+		{
+			const I32 cost = getClusterDistance(mNodes[other].coords);
+			if (other != index && cost >= 0)
+			{
+				Edge edge;
+				edge.node = other;
+				edge.cost = cost;
+				node.edges.push_back(edge);
+			}
+		}
+	}
+}
+
+void HPAStar::searchCluster(const oe::Vector2i& from, U32 cluster, const CollisionMatrix& map)
+{
+	getClusterBounds(cluster, mClusterMin, mClusterMax);
+	std::fill(mClusterDistances.begin(), mClusterDistances.end(), -1);
+
+	const U32 source = (from.x - mClusterMin.x) + (from.y - mClusterMin.y) * mClusterSize;
+	mClusterDistances[source] = 0;
+	mClusterParents[source] = InvalidIndex;
+	mClusterQueue.clear();
+	mClusterQueue.push_back(source);
+	for (U32 i = 0; i < mClusterQueue.size(); i++)
+	{
+		const U32 current = mClusterQueue[i];
+		const I32 distance = mClusterDistances[current] + 1;
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(oe::Vector2i(mClusterMin.x + current % mClusterSize, mClusterMin.y + current / mClusterSize)))
+		{
+			if (neighbor.x < mClusterMin.x || neighbor.y < mClusterMin.y || neighbor.x >= mClusterMax.x || neighbor.y >= mClusterMax.y || map.get(neighbor))
+			{
+				continue;
+			}
+			const U32 index = (neighbor.x - mClusterMin.x) + (neighbor.y - mClusterMin.y) * mClusterSize;
+			if (mClusterDistances[index] < 0)
+			{
+				mClusterDistances[index] = distance;
+				mClusterParents[index] = current;
+				mClusterQueue.push_back(index);
+			}
+		}
+	}
+}
+
+I32 HPAStar::getClusterDistance(const oe::Vector2i& coords) const
+{
+	if (coords.x < mClusterMin.x || coords.y < mClusterMin.y || coords.x >= mClusterMax.x || coords.y >= mClusterMax.y)
+	{
+		return -1;
+	}
+	return mClusterDistances[(coords.x - mClusterMin.x) + (coords.y - mClusterMin.y) * mClusterSize];
+}
+
+void HPAStar::appendClusterPath(std::list<oe::Vector2i>& path, const oe::Vector2i& to) const
+{
+	ASSERT(getClusterDistance(to) >= 0);
+	auto position = path.end();
+	U32 index = (to.x - mClusterMin.x) + (to.y - mClusterMin.y) * mClusterSize;
+	while (mClusterParents[index] != InvalidIndex)
+	{
+		position = path.emplace(position, mClusterMin.x + index % mClusterSize, mClusterMin.y + index / mClusterSize);
+		index = mClusterParents[index];
+	}
+}
+
+bool HPAStar::searchAbstract(const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map)
+{
+	const U32 startNode = mNodes.size();
+	const U32 endNode = startNode + 1;
+	const U32 startCluster = getCluster(start);
+	const U32 endCluster = getCluster(end);
+	mStart = start;
+	mEnd = end;
+
+	// Link the start and the end to the nodes of their clusters
+	Edge edge;
+	mStartEdges.clear();
+	searchCluster(start, startCluster, map);
+	for (U32 index : mClusters[startCluster].nodes)
+	{
+		edge.node = index;
+		edge.cost = getClusterDistance(mNodes[index].coords);
+		if (edge.cost >= 0)
+		{
+			mStartEdges.push_back(edge);
+		}
+	}
+	const I32 directCost = (startCluster == endCluster) ? getClusterDistance(end) : -1;
+	mEndEdges.clear();
+	searchCluster(end, endCluster, map);
+	for (U32 index : mClusters[endCluster].nodes)
+	{
+		edge.node = index;
+		edge.cost = getClusterDistance(mNodes[index].coords);
+		if (edge.cost >= 0)
+		{
+			mEndEdges.push_back(edge);
+		}
+	}
+
+	if (mSearchNodes.size() < endNode + 1)
+	{
+		const SearchNode node = { 0, 0, InvalidIndex, false };
+		mSearchNodes.resize(endNode + 1, node);
+	}
+	mGeneration++;
+	if (mGeneration == 0) // Wrapped : old nodes could look valid
+	{
+		for (SearchNode& node : mSearchNodes)
+		{
+			node.generation = 0;
+		}
+		mGeneration = 1;
+	}
+
+	mOpen.clear();
+	mSearchNodes[startNode] = { mGeneration, 0, InvalidIndex, false };
+	mOpen.emplace_back(AStar::distance(start, end), startNode);
+	while (!mOpen.empty())
+	{
+		std::pop_heap(mOpen.begin(), mOpen.end(), std::greater<std::pair<I32, U32>>());
+		const U32 current = mOpen.back().second;
+		mOpen.pop_back();
+
+		SearchNode& currentNode = mSearchNodes[current];
+		if (currentNode.closed)
+		{
+			continue;
+		}
+		currentNode.closed = true;
+		mStats.abstractExpansions++;
+
+		if (current == endNode)
+		{
+			mAbstractPath.clear();
+			for (U32 index = endNode; index != InvalidIndex; index = mSearchNodes[index].parent)
+			{
+				mAbstractPath.push_back(index);
+			}
+			std::reverse(mAbstractPath.begin(), mAbstractPath.end());
+			return true;
+		}
+
+		const I32 gScore = currentNode.gScore;
+		if (current == startNode)
+		{
+			for (const Edge& startEdge : mStartEdges)
+			{
+				relax(current, startEdge.node, gScore + startEdge.cost);
+			}
+			if (directCost >= 0)
+			{
+				relax(current, endNode, gScore + directCost);
+			}
+		}
+		else
+		{
+			const Node& node = mNodes[current];
+			for (const Edge& nodeEdge : node.edges)
+			{
+				relax(current, nodeEdge.node, gScore + nodeEdge.cost);
+			}
+			for (U32 link : node.links)
+			{
+				relax(current, link, gScore + 1);
+			}
+			if (node.cluster == endCluster)
+			{
+				for (const Edge& endEdge : mEndEdges)
+				{
+					if (endEdge.node == current)
+					{
+						relax(current, endNode, gScore + endEdge.cost);
+						break;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void HPAStar::relax(U32 current, U32 next, I32 gScore)
+{
+	SearchNode& node = mSearchNodes[next];
+	if (node.generation != mGeneration)
+	{
+		node = { mGeneration, gScore, current, false };
+	}
+	else if (!node.closed && gScore < node.gScore)
+	{
+		node.gScore = gScore;
+		node.parent = current;
+	}
+	else
+	{
+		return;
+	}
+	mOpen.emplace_back(gScore + AStar::distance(getAbstractCoords(next), mEnd), next);
+	std::push_heap(mOpen.begin(), mOpen.end(), std::greater<std::pair<I32, U32>>());
+}
+
+const oe::Vector2i& HPAStar::getAbstractCoords(U32 node) const
+{
+	if (node == mNodes.size())
+	{
+		return mStart;
+	}
+	if (node == mNodes.size() + 1)
+	{
+		return mEnd;
+	}
+	return mNodes[node].coords;
+}
+
+void HPAStar::refine(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, U32 maxSteps)
+{
+	const U32 count = mNodes.size();
+	for (U32 i = 1; i < mAbstractPath.size(); i++)
+	{
+		if (maxSteps > 0 && path.size() >= maxSteps)
+		{
+			return;
+		}
+
+		const U32 from = mAbstractPath[i - 1];
+		const U32 to = mAbstractPath[i];
+		if (from < count && to < count && mNodes[from].cluster != mNodes[to].cluster)
+		{
+			path.push_back(mNodes[to].coords); // Transition
+		}
+		else
+		{
+			const U32 cluster = (from < count) ? mNodes[from].cluster : getCluster(start);
+			searchCluster(getAbstractCoords(from), cluster, map);
+			appendClusterPath(path, getAbstractCoords(to));
+		}
+	}
+	ASSERT(path.back() == end);
+}
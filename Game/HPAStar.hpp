@@ -0,0 +1,148 @@
+#ifndef HPASTAR_HPP
+#define HPASTAR_HPP
+
+#include "Pathfinding.hpp"
+
+// Hierarchical A* : the map is cut in square clusters linked by entrances on their borders
+// The search runs on the graph of entrances, then only the first steps of the path are refined in the clusters
+// Changing a cell only marks its cluster, the graph is updated around the dirty clusters on the next query
+class HPAStar
+{
+	public:
+		struct Stats
+		{
+			Stats();
+
+			U32 abstractExpansions; // Last query
+			oe::Time time; // Last query, with the update of the graph
+			U32 queries;
+			U32 flatQueries; // Start and end too close : solved with AStarSearch
+			U32 rebuiltClusters;
+			U32 nodes;
+		};
+
+		HPAStar(I32 clusterSize = 16);
+
+		void setClusterSize(I32 clusterSize);
+		I32 getClusterSize() const;
+
+		void onCollisionChanged(const oe::Vector2i& coords);
+		void invalidate();
+
+		// Used to reject unreachable ends without searching, it must be up to date with the map given to the queries
+		void setConnectivity(const ConnectivityIndex* connectivity);
+
+		// Same format as AStar::run, but the path is only refined until it has maxSteps steps (all if 0)
+		bool run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, U32 maxSteps = 0);
+
+		const Stats& getStats() const;
+		void resetStats();
+
+	private:
+		static const U32 InvalidIndex = 0xFFFFFFFF;
+
+		struct Edge
+		{
+			U32 node;
+			I32 cost;
+		};
+
+		struct Node
+		{
+			oe::Vector2i coords;
+			U32 cluster;
+			U32 references; // Number of transitions using this node
+			std::vector<Edge> edges; // Nodes of the same cluster
+			std::vector<U32> links; // Nodes of other clusters, one step away
+		};
+
+		// Two cells on each side of a border
+		struct Transition
+		{
+			U32 first;
+			U32 second;
+		};
+
+		struct Cluster
+		{
+			std::vector<U32> nodes;
+			bool dirty;
+		};
+
+		struct SearchNode
+		{
+			U32 generation;
+			I32 gScore;
+			U32 parent;
+			bool closed;
+		};
+
+		void update(const CollisionMatrix& map);
+		void build(const CollisionMatrix& map);
+
+		U32 getCluster(const oe::Vector2i& coords) const;
+		void getClusterBounds(U32 cluster, oe::Vector2i& min, oe::Vector2i& max) const;
+
+		// Borders are stored on their first cluster, with the direction of the second one
+		bool getBorder(U32 cluster, U32 direction, bool forward, U32& border) const;
+		U32 getBorderSecondCluster(U32 border) const;
+		void clearBorder(U32 border);
+		void scanBorder(U32 border, const CollisionMatrix& map);
+
+		U32 getNode(const oe::Vector2i& coords, U32 cluster);
+		void removeUnusedNodes(U32 cluster);
+		void computeEdges(U32 cluster, const CollisionMatrix& map);
+
+		// Breadth-first search limited to a cluster, the source can be a wall
+		void searchCluster(const oe::Vector2i& from, U32 cluster, const CollisionMatrix& map);
+		I32 getClusterDistance(const oe::Vector2i& coords) const;
+		void appendClusterPath(std::list<oe::Vector2i>& path, const oe::Vector2i& to) const;
+
+		bool searchAbstract(const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map);
+		void relax(U32 current, U32 next, I32 gScore);
+		const oe::Vector2i& getAbstractCoords(U32 node) const;
+		void refine(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, U32 maxSteps);
+
+	private:
+		I32 mClusterSize;
+		oe::Vector2i mClusterCount;
+		oe::Vector2i mMapSize;
+		bool mBuilt;
+
+		std::vector<Cluster> mClusters;
+		std::vector<U32> mDirtyClusters;
+		std::vector<std::vector<Transition>> mBorders;
+		std::vector<Node> mNodes;
+		std::vector<U32> mFreeNodes;
+		oe::HexGrid<U32> mCellNodes;
+
+		// Update
+		std::vector<U32> mUpdateBorders;
+		std::vector<U32> mUpdateClusters;
+		std::vector<bool> mBorderMarks;
+		std::vector<bool> mClusterMarks;
+		std::vector<std::pair<oe::Vector2i, oe::Vector2i>> mPairs;
+
+		// Cluster search
+		oe::Vector2i mClusterMin;
+		oe::Vector2i mClusterMax;
+		std::vector<I32> mClusterDistances;
+		std::vector<U32> mClusterParents;
+		std::vector<U32> mClusterQueue;
+
+		// Abstract search : the start and the end are two extra nodes after the real ones
+		std::vector<Edge> mStartEdges;
+		std::vector<Edge> mEndEdges;
+		std::vector<SearchNode> mSearchNodes;
+		std::vector<std::pair<I32, U32>> mOpen;
+		std::vector<U32> mAbstractPath;
+		oe::Vector2i mStart;
+		oe::Vector2i mEnd;
+		U32 mGeneration;
+
+		AStarSearch mFlatSearch;
+		const ConnectivityIndex* mConnectivity;
+		Stats mStats;
+};
+
+#endif // HPASTAR_HPP
@@ -16,6 +16,10 @@ LifeComponent::LifeComponent(oe::Entity& entity)
 	mBar.setOutlineThickness(1.f);
 	mBar.setSize(sf::Vector2f(0.f, 5.f));
 	mBar.setFillColor(sf::Color::Green);
+
+	// Bar and its outline
+	mLocalAABB = sf::FloatRect(-1.f, -1.f, 52.f, 7.f);
+	invalidateLocalAABB();
 }
 
 void LifeComponent::setLifeMax(U32 lifeMax)
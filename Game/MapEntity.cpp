@@ -6,12 +6,20 @@ MapEntity::MapEntity(oe::World& world)
 	: oe::Entity(world)
 	, mResourceComponent(*this)
 	, mLifeComponent(*this)
+	, mCellPrevious(nullptr)
+	, mCellNext(nullptr)
+	, mCellEpoch(0)
 	, mPlayer(0)
 	, mLife(0)
 {
 	setCoords(oe::Vector2i(0, 0));
 }
 
+MapEntity::~MapEntity()
+{
+	GameSingleton::occupancy.remove(this);
+}
+
 void MapEntity::setCoords(I32 x, I32 y)
 {
 	setCoords(oe::Vector2i(x, y));
@@ -19,7 +27,7 @@ void MapEntity::setCoords(I32 x, I32 y)
 
 void MapEntity::setCoords(const oe::Vector2i& coords)
 {
-	mCoords = coords;
+	setCellCoords(coords);
 	setPosition(GameSingleton::map->coordsToWorld(coords));
 }
 
@@ -85,3 +93,10 @@ void MapEntity::takeResources(U32 resources)
 	mResources -= resources;
 	mResourceComponent.setResources(mResources);
 }
+
+void MapEntity::setCellCoords(const oe::Vector2i& coords)
+{
+	GameSingleton::occupancy.remove(this);
+	mCoords = coords;
+	GameSingleton::occupancy.insert(this);
+}
@@ -8,8 +8,11 @@
 
 class MapEntity : public oe::Entity
 {
+	OeEntity(MapEntity, oe::Entity)
+
 	public:
 		MapEntity(oe::World& world);
+		~MapEntity();
 
 		void setCoords(I32 x, I32 y);
 		void setCoords(const oe::Vector2i& coords);
@@ -28,11 +31,19 @@ class MapEntity : public oe::Entity
 		void takeResources(U32 resources);
 
 	protected:
+		// Changes the cell without moving the node, while the move is animated
+		void setCellCoords(const oe::Vector2i& coords);
+
 		ResourceComponent mResourceComponent;
 		LifeComponent mLifeComponent;
 		oe::Vector2i mCoords;
 
 	private:
+		friend class OccupancyIndex;
+		MapEntity* mCellPrevious;
+		MapEntity* mCellNext;
+		U32 mCellEpoch;
+
 		U32 mPlayer;
 		U32 mLife;
 		U32 mResources;
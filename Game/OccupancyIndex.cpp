@@ -0,0 +1,79 @@
+#include "OccupancyIndex.hpp"
+
+const U32 OccupancyIndex::AnyPlayer;
+
+OccupancyIndex::OccupancyIndex()
+	: mCells()
+	, mCount(0)
+	, mEpoch(1)
+{
+}
+
+void OccupancyIndex::create(const oe::Vector2i& size)
+{
+	mCells.create(size, nullptr);
+	mCount = 0;
+	mEpoch++;
+}
+
+void OccupancyIndex::clear()
+{
+	mCells.clear();
+	mCount = 0;
+	mEpoch++;
+}
+
+bool OccupancyIndex::contains(const oe::Vector2i& coords) const
+{
+	return mCells.contains(coords);
+}
+
+void OccupancyIndex::insert(MapEntity* entity)
+{
+	ASSERT(entity != nullptr && entity->mCellEpoch != mEpoch);
+	const oe::Vector2i& coords = entity->getCoords();
+	if (!mCells.contains(coords))
+	{
+		return;
+	}
+	MapEntity*& head = mCells[coords];
+	entity->mCellPrevious = nullptr;
+	entity->mCellNext = head;
+	if (head != nullptr)
+	{
+		head->mCellPrevious = entity;
+	}
+	head = entity;
+	entity->mCellEpoch = mEpoch;
+	mCount++;
+}
+
+void OccupancyIndex::remove(MapEntity* entity)
+{
+	ASSERT(entity != nullptr);
+	if (entity->mCellEpoch != mEpoch)
+	{
+		return;
+	}
+	if (entity->mCellPrevious != nullptr)
+	{
+		entity->mCellPrevious->mCellNext = entity->mCellNext;
+	}
+	else
+	{
+		mCells[entity->getCoords()] = entity->mCellNext;
+	}
+	if (entity->mCellNext != nullptr)
+	{
+		entity->mCellNext->mCellPrevious = entity->mCellPrevious;
+	}
+	entity->mCellPrevious = nullptr;
+	entity->mCellNext = nullptr;
+	entity->mCellEpoch = 0;
+	mCount--;
+}
+
+U32 OccupancyIndex::getCount() const
+{
+	return mCount;
+}
@@ -0,0 +1,99 @@
+#ifndef OCCUPANCYINDEX_HPP
+#define OCCUPANCYINDEX_HPP
+
+#include "../Sources/System/HexGrid.hpp"
+
+#include "MapEntity.hpp"
+
+#include <algorithm>
+
+// Map entities of each cell, kept up to date by MapEntity::setCoords and the destructor of MapEntity
+// A killed entity stays in its cell until the world destroys it, like in the entity lists
+// Each cell is the head of an intrusive list through the entities : insert and remove are O(1), a lookup is O(entities in the cell)
+class OccupancyIndex
+{
+	public:
+		static const U32 AnyPlayer = 0;
+
+		OccupancyIndex();
+
+		void create(const oe::Vector2i& size);
+		void clear();
+		bool contains(const oe::Vector2i& coords) const;
+
+		// At entity->getCoords(), ignored outside of the map
+		void insert(MapEntity* entity);
+		void remove(MapEntity* entity);
+
+		// First entity of type T (see OeEntity) in the cell, owned by player
+		template <typename T>
+		T* get(const oe::Vector2i& coords, U32 player = AnyPlayer) const;
+
+		// Entities of the cell, and of the cells at a hex distance <= radius from center (k-ring)
+		template <typename F>
+		void forEach(const oe::Vector2i& coords, F function) const;
+		template <typename F>
+		void forEachInRange(const oe::Vector2i& center, U32 radius, F function) const;
+
+		U32 getCount() const;
+
+	private:
+		oe::HexGrid<MapEntity*> mCells;
+		U32 mCount;
+		U32 mEpoch; // Entities inserted before the last create or clear are not in the cells anymore
+};
+
+template <typename T>
+T* OccupancyIndex::get(const oe::Vector2i& coords, U32 player) const
+{
+	for (MapEntity* entity = mCells.get(coords, nullptr); entity != nullptr; entity = entity->mCellNext)
+	{
+		if (entity->isA<T>() && (player == AnyPlayer || entity->getPlayer() == player))
+		{
+			return static_cast<T*>(entity);
+		}
+	}
+	return nullptr;
+}
+
+template <typename F>
+void OccupancyIndex::forEach(const oe::Vector2i& coords, F function) const
+{
+	MapEntity* entity = mCells.get(coords, nullptr);
+	while (entity != nullptr)
+	{
+		// The function can move the entity
+		MapEntity* next = entity->mCellNext;
+		function(*entity);
+		entity = next;
+	}
+}
+
+template <typename F>
+void OccupancyIndex::forEachInRange(const oe::Vector2i& center, U32 radius, F function) const
+{
+	// Rows of the ring in axial coordinates (same as AStar::distance), back to offset coordinates for each cell
+	const I32 k = static_cast<I32>(radius);
+	const I32 centerQ = center.x - (center.y - (center.y & 1)) / 2;
+	for (I32 dr = -k; dr <= k; dr++)
+	{
+		const I32 y = center.y + dr;
+		if (y < 0 || y >= mCells.getSize().y)
+		{
+			continue;
+		}
+		const I32 offset = (y - (y & 1)) / 2;
+		const I32 dqMin = std::max(-k, -dr - k);
+		const I32 dqMax = std::min(k, -dr + k);
+		for (I32 dq = dqMin; dq <= dqMax; dq++)
+		{
+			const oe::Vector2i coords(centerQ + dq + offset, y);
+			if (mCells.contains(coords))
+			{
+				forEach(coords, function);
+			}
+		}
+	}
+}
+
+#endif // OCCUPANCYINDEX_HPP
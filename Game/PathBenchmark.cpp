@@ -0,0 +1,248 @@
+#include "PathBenchmark.hpp"
+#include "Connectivity.hpp"
+#include "HPAStar.hpp"
+#include "GameConfig.hpp"
+
+#include "../Sources/Math/Random.hpp"
+#include "../Sources/System/Log.hpp"
+#include "../Sources/System/String.hpp"
+
+const U32 PathBenchmark::WallPercent;
+const U32 PathBenchmark::TurnSteps;
+const U32 PathBenchmark::NeighborPasses;
+
+void PathBenchmark::run(U32 queries)
+{
+	runMap(256, queries);
+	runMap(1024, queries);
+	runNeighbors(256, NeighborPasses);
+}
+
+void PathBenchmark::runMap(I32 size, U32 queries)
+{
+	CollisionMatrix map;
+	generate(map, size);
+	ConnectivityIndex connectivity;
+	connectivity.build(map);
+	AStar::setConnectivity(&connectivity);
+
+	// The first query builds the whole graph, without the connectivity it can't be skipped
+	HPAStar hierarchy(HPACLUSTERSIZE);
+	std::list<oe::Vector2i> path;
+	const oe::Vector2i first(getFreeCell(map));
+	oe::Vector2i second;
+	do
+	{
+		second = getFreeCell(map);
+	} while (second == first);
+	oe::Clock clock;
+	hierarchy.run(path, first, second, map, TurnSteps);
+	const oe::Time buildTime = clock.getElapsedTime();
+	hierarchy.setConnectivity(&connectivity);
+
+	oe::Time aStarTime;
+	oe::Time hierarchyTime;
+	oe::Time turnTime;
+	U64 aStarLength = 0;
+	U64 hierarchyLength = 0;
+	U32 found = 0;
+	for (U32 i = 0; i < queries; i++)
+	{
+		const oe::Vector2i start(getFreeCell(map));
+		const oe::Vector2i end(getFreeCell(map));
+
+		clock.restart();
+		const bool aStarFound = AStar::run(path, start, end, map);
+		aStarTime = aStarTime + clock.getElapsedTime();
+		const U32 length = path.size();
+
+		clock.restart();
+		const bool hierarchyFound = hierarchy.run(path, start, end, map);
+		hierarchyTime = hierarchyTime + clock.getElapsedTime();
+
+		clock.restart();
+		hierarchy.run(path, start, end, map, TurnSteps);
+		turnTime = turnTime + clock.getElapsedTime();
+
+		// Both find the same ends, the hierarchy only gives longer paths
+		if (aStarFound && hierarchyFound)
+		{
+			found++;
+			aStarLength += length;
+			hierarchy.run(path, start, end, map);
+			hierarchyLength += path.size();
+		}
+	}
+	AStar::setConnectivity(nullptr);
+
+	const U32 count = (queries > 0) ? queries : 1;
+	const F32 ratio = (aStarLength > 0) ? static_cast<F32>(hierarchyLength) / static_cast<F32>(aStarLength) : 1.0f;
+	oe::info(oe::toString(size) + "x" + oe::toString(size) + " : " + oe::toString(found) + "/" + oe::toString(queries) + " paths found, graph built in " + oe::toString(buildTime.asMilliseconds()) + "ms");
+	oe::info("  AStar::run " + oe::toString(aStarTime.asMicroseconds() / count) + "us per query");
+	oe::info("  HPAStar " + oe::toString(hierarchyTime.asMicroseconds() / count) + "us per query, " + oe::toString(turnTime.asMicroseconds() / count) + "us refining " + oe::toString(TurnSteps) + " steps");
+	oe::info("  HPAStar paths " + oe::toString(ratio) + "x the length of AStar::run");
+}
+
+void PathBenchmark::generate(CollisionMatrix& map, I32 size)
+{
+	map.create(size, size);
+	oe::Vector2i coords;
+	for (coords.y = 0; coords.y < size; coords.y++)
+	{
+		for (coords.x = 0; coords.x < size; coords.x++)
+		{
+			map.set(coords, oe::Random::get<U32>(0, 99) < WallPercent);
+		}
+	}
+}
+
+oe::Vector2i PathBenchmark::getFreeCell(const CollisionMatrix& map)
+{
+	const oe::Vector2i& size = map.getSize();
+	oe::Vector2i coords;
+	do
+	{
+		coords.x = oe::Random::get<I32>(0, size.x - 1);
+		coords.y = oe::Random::get<I32>(0, size.y - 1);
+	} while (map.get(coords));
+	return coords;
+}
+
+void PathBenchmark::runNeighbors(I32 size, U32 passes)
+{
+	if (!checkNeighbors())
+	{
+		oe::error("Neighbors : HexNeighbors or forEachHexNeighbor differ from getNeighboors");
+		return;
+	}
+
+	// The sums are logged so that no loop can be removed
+	oe::Clock clock;
+	oe::Vector2i coords;
+	I64 sums[4] = { 0, 0, 0, 0 };
+	oe::Time times[4];
+
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (coords.y = 0; coords.y < size; coords.y++)
+		{
+			for (coords.x = 0; coords.x < size; coords.x++)
+			{
+				for (const oe::Vector2i& neighbor : oe::MapUtility::getNeighboors(coords, oe::MapUtility::Hexagonal))
+				{
+					sums[0] += neighbor.x + neighbor.y;
+				}
+			}
+		}
+	}
+	times[0] = clock.restart();
+
+	std::vector<oe::Vector2i> neighbors;
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (coords.y = 0; coords.y < size; coords.y++)
+		{
+			for (coords.x = 0; coords.x < size; coords.x++)
+			{
+				neighbors.clear();
+				oe::MapUtility::getNeighboors(neighbors, coords, oe::MapUtility::Hexagonal);
+				for (const oe::Vector2i& neighbor : neighbors)
+				{
+					sums[1] += neighbor.x + neighbor.y;
+				}
+			}
+		}
+	}
+	times[1] = clock.restart();
+
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (coords.y = 0; coords.y < size; coords.y++)
+		{
+			for (coords.x = 0; coords.x < size; coords.x++)
+			{
+				for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(coords))
+				{
+					sums[2] += neighbor.x + neighbor.y;
+				}
+			}
+		}
+	}
+	times[2] = clock.restart();
+
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (coords.y = 0; coords.y < size; coords.y++)
+		{
+			for (coords.x = 0; coords.x < size; coords.x++)
+			{
+				oe::MapUtility::forEachHexNeighbor(coords, [&sums](const oe::Vector2i& neighbor)
+				{
+					sums[3] += neighbor.x + neighbor.y;
+				});
+			}
+		}
+	}
+	times[3] = clock.restart();
+
+	const char* names[4] = { "getNeighboors returning a vector", "getNeighboors into a reused vector", "HexNeighbors", "forEachHexNeighbor" };
+	oe::info("Neighbors of " + oe::toString(size) + "x" + oe::toString(size) + " cells, " + oe::toString(passes) + " passes");
+	for (U32 i = 0; i < 4; i++)
+	{
+		oe::info("  " + std::string(names[i]) + " " + oe::toString(times[i].asMilliseconds()) + "ms (sum " + oe::toString(sums[i]) + ")");
+	}
+}
+
+bool PathBenchmark::checkNeighbors()
+{
+	// Every stagger, both parities, and negative coordinates
+	const oe::MapUtility::StaggerIndex indices[2] = { oe::MapUtility::StaggerIndex::Odd, oe::MapUtility::StaggerIndex::Even };
+	const oe::MapUtility::StaggerAxis axes[2] = { oe::MapUtility::StaggerAxis::X, oe::MapUtility::StaggerAxis::Y };
+	oe::Vector2i coords;
+	for (oe::MapUtility::StaggerIndex index : indices)
+	{
+		for (oe::MapUtility::StaggerAxis axis : axes)
+		{
+			for (coords.y = -3; coords.y <= 3; coords.y++)
+			{
+				for (coords.x = -3; coords.x <= 3; coords.x++)
+				{
+					const std::vector<oe::Vector2i> expected = oe::MapUtility::getNeighboors(coords, oe::MapUtility::Hexagonal, false, index, axis);
+					const oe::MapUtility::HexNeighbors neighbors(coords, index, axis);
+					if (expected.size() != neighbors.size())
+					{
+						return false;
+					}
+					for (U32 i = 0; i < neighbors.size(); i++)
+					{
+						if (expected[i] != neighbors[i] || !oe::MapUtility::areHexNeighbors(coords, expected[i], index, axis))
+						{
+							return false;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// forEachHexNeighbor for the stagger of the game
+	for (coords.y = -3; coords.y <= 3; coords.y++)
+	{
+		for (coords.x = -3; coords.x <= 3; coords.x++)
+		{
+			const std::vector<oe::Vector2i> expected = oe::MapUtility::getNeighboors(coords, oe::MapUtility::Hexagonal);
+			U32 i = 0;
+			bool same = true;
+			oe::MapUtility::forEachHexNeighbor(coords, [&](const oe::Vector2i& neighbor)
+			{
+				same = same && i < expected.size() && expected[i] == neighbor;
+				i++;
+			});
+			if (!same || i != expected.size())
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
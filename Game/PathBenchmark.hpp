@@ -0,0 +1,28 @@
+#ifndef PATHBENCHMARK_HPP
+#define PATHBENCHMARK_HPP
+
+#include "Pathfinding.hpp"
+
+// HPAStar against AStar::run on random maps, then the ways to iterate hexagonal neighbors
+// The results are written in the log
+// Run with : Arthropoda --benchpath [queries [seed]]
+class PathBenchmark
+{
+	public:
+		static void run(U32 queries);
+
+	private:
+		static void runMap(I32 size, U32 queries);
+		static void generate(CollisionMatrix& map, I32 size);
+		static oe::Vector2i getFreeCell(const CollisionMatrix& map);
+
+		// getNeighboors returning a vector, filling a reused vector, HexNeighbors and forEachHexNeighbor
+		static void runNeighbors(I32 size, U32 passes);
+		static bool checkNeighbors();
+
+		static const U32 WallPercent = 25;
+		static const U32 TurnSteps = 5; // Steps refined by the game for one turn
+		static const U32 NeighborPasses = 200;
+};
+
+#endif // PATHBENCHMARK_HPP
@@ -0,0 +1,268 @@
+#include "PathRequestQueue.hpp"
+#include "Connectivity.hpp"
+
+#include <algorithm>
+
+const PathRequestQueue::RequestId PathRequestQueue::InvalidRequest;
+
+PathRequestQueue::Stats::Stats()
+	: requests(0)
+	, rejected(0)
+	, wait(oe::Time::Zero)
+	, totalRequests(0)
+{
+}
+
+PathRequestQueue::PathRequestQueue()
+	: mJobs(nullptr)
+	, mCounter()
+	, mSearches()
+	, mBatch()
+	, mSnapshot()
+	, mNextRequest(0)
+	, mSubmitted()
+	, mResults()
+	, mSlots()
+	, mSearch()
+	, mNextId(InvalidRequest)
+	, mInFlight(false)
+	, mStats()
+{
+}
+
+PathRequestQueue::~PathRequestQueue()
+{
+	stop();
+}
+
+void PathRequestQueue::start(oe::JobSystem& jobs)
+{
+	if (mJobs != nullptr)
+	{
+		return;
+	}
+	mJobs = &jobs;
+
+	// The caller keeps rendering while the batch is solved, it only helps when it waits in collect()
+	const U32 count = jobs.getThreadCount() - 1;
+	while (mSearches.size() < count)
+	{
+		mSearches.emplace_back(new AStarSearch());
+	}
+	mSearches.resize(count);
+}
+
+void PathRequestQueue::stop()
+{
+	if (mJobs == nullptr)
+	{
+		return;
+	}
+	collect();
+	mJobs = nullptr;
+}
+
+U32 PathRequestQueue::getWorkerCount() const
+{
+	return (mJobs != nullptr) ? mSearches.size() : 0;
+}
+
+PathRequestQueue::RequestId PathRequestQueue::submit(const oe::Vector2i& start, const oe::Vector2i& end, bool blockedEnd)
+{
+	mNextId++;
+	if (mNextId == InvalidRequest)
+	{
+		mNextId++;
+	}
+	Request request;
+	request.id = mNextId;
+	request.start = start;
+	request.end = end;
+	request.blockedEnd = blockedEnd;
+	request.solved = false;
+	request.found = false;
+	mSlots[request.id] = { Location::Submitted, (U32)mSubmitted.size() };
+	mSubmitted.push_back(request);
+	return request.id;
+}
+
+PathRequestQueue::Status PathRequestQueue::getStatus(RequestId id) const
+{
+	auto itr = mSlots.find(id);
+	if (itr == mSlots.end())
+	{
+		return Status::Unknown;
+	}
+	return (itr->second.location == Location::Results) ? Status::Done : Status::Pending;
+}
+
+bool PathRequestQueue::takeResult(RequestId id, std::list<oe::Vector2i>& path)
+{
+	path.clear();
+	auto itr = mSlots.find(id);
+	if (itr == mSlots.end() || itr->second.location != Location::Results)
+	{
+		return false;
+	}
+	// Removed from mResults by the next collect
+	Request& request = mResults[itr->second.index];
+	mSlots.erase(itr);
+	request.id = InvalidRequest;
+	path.swap(request.path);
+	return request.found;
+}
+
+void PathRequestQueue::dispatch(const CollisionMatrix& map, const ConnectivityIndex* connectivity)
+{
+	if (mInFlight)
+	{
+		collect();
+	}
+	if (mSubmitted.empty())
+	{
+		return;
+	}
+
+	// Unreachable ends would exhaust the whole map : reject them now
+	mStats.requests = mSubmitted.size();
+	mStats.rejected = 0;
+	mStats.totalRequests += mSubmitted.size();
+	if (connectivity != nullptr)
+	{
+		for (Request& request : mSubmitted)
+		{
+			if (!connectivity->canReach(request.start, request.end))
+			{
+				request.solved = true;
+				mStats.rejected++;
+			}
+		}
+	}
+
+	// The requests keep their index in the batch
+	for (const Request& request : mSubmitted)
+	{
+		mSlots[request.id].location = Location::Batch;
+	}
+
+	if (getWorkerCount() == 0)
+	{
+		for (Request& request : mSubmitted)
+		{
+			solve(request, mSearch, map);
+		}
+		mBatch.swap(mSubmitted);
+		mSubmitted.clear();
+		mInFlight = true;
+		return;
+	}
+
+	mSnapshot = map;
+	mBatch.swap(mSubmitted);
+	mSubmitted.clear();
+	mNextRequest = 0;
+	mInFlight = true;
+	for (const std::unique_ptr<AStarSearch>& search : mSearches)
+	{
+		AStarSearch* jobSearch = search.get();
+		mJobs->run(mCounter, [this, jobSearch]() { work(*jobSearch); });
+	}
+}
+
+void PathRequestQueue::collect()
+{
+	// Taken and cancelled results
+	const size_t count = mResults.size();
+	mResults.erase(std::remove_if(mResults.begin(), mResults.end(), [](const Request& request) { return request.id == InvalidRequest; }), mResults.end());
+	if (mResults.size() != count)
+	{
+		for (U32 i = 0; i < mResults.size(); i++)
+		{
+			mSlots[mResults[i].id].index = i;
+		}
+	}
+	if (!mInFlight)
+	{
+		return;
+	}
+
+	// The caller runs jobs while it waits, the path jobs or any other
+	oe::Clock clock;
+	if (getWorkerCount() > 0)
+	{
+		mJobs->wait(mCounter);
+	}
+	std::vector<Request> batch;
+	batch.swap(mBatch);
+	mInFlight = false;
+	mStats.wait = clock.getElapsedTime();
+
+	// Requests cancelled while in the batch are no longer indexed
+	for (Request& request : batch)
+	{
+		auto itr = mSlots.find(request.id);
+		if (itr != mSlots.end())
+		{
+			itr->second = { Location::Results, (U32)mResults.size() };
+			mResults.push_back(std::move(request));
+		}
+	}
+}
+
+void PathRequestQueue::cancel(RequestId id)
+{
+	auto itr = mSlots.find(id);
+	if (itr == mSlots.end())
+	{
+		return;
+	}
+	const Slot slot = itr->second;
+	mSlots.erase(itr);
+	if (slot.location == Location::Submitted)
+	{
+		// The last request takes the slot
+		if (slot.index + 1 < mSubmitted.size())
+		{
+			mSubmitted[slot.index] = std::move(mSubmitted.back());
+			mSlots[mSubmitted[slot.index].id].index = slot.index;
+		}
+		mSubmitted.pop_back();
+	}
+	else if (slot.location == Location::Results)
+	{
+		mResults[slot.index].id = InvalidRequest;
+	}
+	// In the batch : dropped by collect
+}
+
+void PathRequestQueue::clear()
+{
+	collect();
+	mResults.clear();
+	mSubmitted.clear();
+	mSlots.clear();
+}
+
+const PathRequestQueue::Stats& PathRequestQueue::getStats() const
+{
+	return mStats;
+}
+
+void PathRequestQueue::work(AStarSearch& search)
+{
+	// Each job takes the next request until the batch is empty : long searches don't hold the others
+	const U32 count = mBatch.size();
+	for (U32 index = mNextRequest++; index < count; index = mNextRequest++)
+	{
+		solve(mBatch[index], search, mSnapshot);
+	}
+}
+
+void PathRequestQueue::solve(Request& request, AStarSearch& search, const CollisionMatrix& map)
+{
+	if (!request.solved)
+	{
+		request.found = search.run(request.path, request.start, request.end, map, request.blockedEnd);
+		request.solved = true;
+	}
+}
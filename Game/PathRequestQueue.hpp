@@ -0,0 +1,117 @@
+#ifndef PATHREQUESTQUEUE_HPP
+#define PATHREQUESTQUEUE_HPP
+
+#include "../Sources/System/JobSystem.hpp"
+
+#include "Pathfinding.hpp"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+// Path requests solved in parallel by jobs of the application
+// Requests submitted during a frame are sent to the jobs by dispatch() with a copy of the map,
+// the results are available after collect() at the beginning of the next frame
+// Only the jobs run outside of the main thread
+class PathRequestQueue
+{
+	public:
+		using RequestId = U32;
+		static const RequestId InvalidRequest = 0;
+
+		enum class Status
+		{
+			Unknown, // Never submitted, taken, or dropped
+			Pending,
+			Done,
+		};
+
+		struct Stats
+		{
+			Stats();
+
+			U32 requests; // Last batch
+			U32 rejected; // Last batch, unreachable ends
+			oe::Time wait; // Last collect
+			U64 totalRequests;
+		};
+
+		PathRequestQueue();
+		~PathRequestQueue();
+
+		PathRequestQueue(const PathRequestQueue&) = delete;
+		void operator=(const PathRequestQueue&) = delete;
+
+		// One job per thread of the job system but the caller, solved on the caller with a single thread
+		void start(oe::JobSystem& jobs);
+		void stop();
+		U32 getWorkerCount() const; // Jobs of a batch
+
+		// Same format as AStar::run
+		RequestId submit(const oe::Vector2i& start, const oe::Vector2i& end, bool blockedEnd = false);
+		Status getStatus(RequestId id) const;
+		bool takeResult(RequestId id, std::list<oe::Vector2i>& path);
+
+		// End of the frame
+		void dispatch(const CollisionMatrix& map, const ConnectivityIndex* connectivity = nullptr);
+
+		// Beginning of the frame : waits for the workers, results are kept until taken or cancelled
+		void collect();
+
+		void cancel(RequestId id);
+
+		void clear();
+
+		const Stats& getStats() const;
+
+	private:
+		struct Request
+		{
+			RequestId id;
+			oe::Vector2i start;
+			oe::Vector2i end;
+			bool blockedEnd;
+			bool solved;
+			bool found;
+			std::list<oe::Vector2i> path;
+		};
+
+		// Where a request is kept, for the main thread
+		enum class Location
+		{
+			Submitted,
+			Batch,
+			Results,
+		};
+
+		struct Slot
+		{
+			Location location;
+			U32 index;
+		};
+
+		void work(AStarSearch& search);
+		void solve(Request& request, AStarSearch& search, const CollisionMatrix& map);
+
+	private:
+		oe::JobSystem* mJobs;
+		oe::JobSystem::Counter mCounter;
+		std::vector<std::unique_ptr<AStarSearch>> mSearches; // One by job : nodes and heap are reused between batches
+
+		// Read by the jobs, only changed by the main thread when no batch is in flight
+		std::vector<Request> mBatch;
+		CollisionMatrix mSnapshot;
+		std::atomic<U32> mNextRequest;
+
+		// Main thread
+		std::vector<Request> mSubmitted;
+		std::vector<Request> mResults;
+		std::unordered_map<RequestId, Slot> mSlots; // Requests not taken nor cancelled
+		AStarSearch mSearch; // Without jobs
+		RequestId mNextId;
+		bool mInFlight;
+
+		Stats mStats;
+};
+
+#endif // PATHREQUESTQUEUE_HPP
@@ -0,0 +1,493 @@
+#include "Pathfinding.hpp"
+#include "Connectivity.hpp"
+
+#include <algorithm>
+
+const U32 CollisionMatrix::JournalSize;
+
+void CollisionMatrix::set(const oe::Vector2i& coords, const bool& val)
+{
+	if (mGrid.contains(coords) && mGrid[coords] != val)
+	{
+		mGrid.set(coords, val);
+		mJournal[mVersion % mJournal.size()] = coords;
+		mVersion++;
+	}
+}
+
+bool CollisionMatrix::getChanges(U32 version, std::vector<oe::Vector2i>& changes) const
+{
+	if (version < mJournalStart || version > mVersion || mVersion - version > mJournal.size())
+	{
+		return false;
+	}
+	for (U32 v = version; v < mVersion; v++)
+	{
+		changes.push_back(mJournal[v % mJournal.size()]);
+	}
+	return true;
+}
+
+void CollisionMatrix::reserveJournal(U32 size)
+{
+	const U32 previousSize = mJournal.size();
+	if (size <= previousSize)
+	{
+		return;
+	}
+
+	// The kept changes move to their slot in the bigger ring
+	std::vector<oe::Vector2i> journal(size);
+	const U32 kept = std::min(mVersion - mJournalStart, previousSize);
+	for (U32 v = mVersion - kept; v < mVersion; v++)
+	{
+		journal[v % size] = mJournal[v % previousSize];
+	}
+	mJournal.swap(journal);
+	mJournalStart = mVersion - kept; // Older changes were lost before the journal grew
+}
+
+void CollisionMatrix::resetJournal()
+{
+	mVersion++;
+	mJournalStart = mVersion;
+}
+
+AStarSearch::Stats::Stats()
+	: expansions(0)
+	, time(oe::Time::Zero)
+	, queries(0)
+	, totalExpansions(0)
+	, totalTime(oe::Time::Zero)
+{
+}
+
+AStarSearch::AStarSearch()
+	: mNodes()
+	, mHeap()
+	, mGeneration(0)
+	, mConnectivity(nullptr)
+	, mStats()
+{
+}
+
+bool AStarSearch::run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, bool blockedEnd)
+{
+	path.clear();
+
+	if (start == end || !search(start, end, map, blockedEnd))
+	{
+		return false;
+	}
+
+	const U32 startIndex = mNodes.toIndex(start);
+	U32 index = mNodes.toIndex(end);
+	while (index != startIndex)
+	{
+		path.emplace_front(mNodes.toCoords(index));
+		index = mNodes[index].parent;
+	}
+	return true;
+}
+
+bool AStarSearch::canGo(const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, bool blockedEnd)
+{
+	return start == end || search(start, end, map, blockedEnd);
+}
+
+void AStarSearch::setConnectivity(const ConnectivityIndex* connectivity)
+{
+	mConnectivity = connectivity;
+}
+
+const AStarSearch::Stats& AStarSearch::getStats() const
+{
+	return mStats;
+}
+
+void AStarSearch::resetStats()
+{
+	mStats = Stats();
+}
+
+bool AStarSearch::search(const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, bool blockedEnd)
+{
+	oe::Clock clock;
+	bool found = false;
+	mStats.expansions = 0;
+
+	// The start can be a wall (the cell of the ant), the end only if asked
+	// Unreachable ends would exhaust the whole map : reject them with the connectivity first
+	if (map.getGrid().contains(start) && map.getGrid().contains(end) && (blockedEnd || !map.get(end))
+		&& (mConnectivity == nullptr || mConnectivity->canReach(start, end)))
+	{
+		prepare(map.getSize());
+		open(mNodes.toIndex(start), 0, AStar::distance(start, end), InvalidIndex);
+		found = expand(end, map);
+	}
+
+	mStats.time = clock.getElapsedTime();
+	mStats.queries++;
+	mStats.totalExpansions += mStats.expansions;
+	mStats.totalTime += mStats.time;
+	return found;
+}
+
+bool AStarSearch::expand(const oe::Vector2i& end, const CollisionMatrix& map)
+{
+	const U32 endIndex = mNodes.toIndex(end);
+	while (!mHeap.empty())
+	{
+		const U32 current = heapPop();
+		if (current == endIndex)
+		{
+			return true;
+		}
+
+		mNodes[current].closedGeneration = mGeneration;
+		mStats.expansions++;
+
+		const I32 gScore = mNodes[current].gScore + 1;
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(mNodes.toCoords(current)))
+		{
+			if (map.get(neighbor) && neighbor != end) // Wall or outside of the map, a blocked end has been accepted by search()
+			{
+				continue;
+			}
+			const U32 index = mNodes.toIndex(neighbor);
+			Node& node = mNodes[index];
+			if (node.closedGeneration == mGeneration)
+			{
+				continue;
+			}
+			if (node.generation != mGeneration)
+			{
+				open(index, gScore, gScore + AStar::distance(neighbor, end), current);
+			}
+			else if (gScore < node.gScore) // Decrease key
+			{
+				node.fScore = gScore + (node.fScore - node.gScore);
+				node.gScore = gScore;
+				node.parent = current;
+				heapUp(node.heapPosition);
+			}
+		}
+	}
+	return false;
+}
+
+void AStarSearch::prepare(const oe::Vector2i& size)
+{
+	if (mNodes.getSize() != size)
+	{
+		const Node node = { 0, 0, 0, 0, InvalidIndex, InvalidIndex };
+		mNodes.create(size, node);
+		mGeneration = 0;
+	}
+	mHeap.clear();
+
+	mGeneration++;
+	if (mGeneration == 0) // Wrapped : old nodes could look valid
+	{
+		for (U32 i = 0; i < mNodes.getStorageSize(); i++)
+		{
+			mNodes[i].generation = 0;
+			mNodes[i].closedGeneration = 0;
+		}
+		mGeneration = 1;
+	}
+}
+
+void AStarSearch::open(U32 index, I32 gScore, I32 fScore, U32 parent)
+{
+	Node& node = mNodes[index];
+	node.generation = mGeneration;
+	node.gScore = gScore;
+	node.fScore = fScore;
+	node.parent = parent;
+	heapPush(index);
+}
+
+void AStarSearch::heapPush(U32 index)
+{
+	mNodes[index].heapPosition = mHeap.size();
+	mHeap.push_back(index);
+	heapUp(mHeap.size() - 1);
+}
+
+U32 AStarSearch::heapPop()
+{
+	ASSERT(!mHeap.empty());
+	const U32 top = mHeap.front();
+	const U32 last = mHeap.back();
+	mHeap.pop_back();
+	if (!mHeap.empty())
+	{
+		mHeap[0] = last;
+		mNodes[last].heapPosition = 0;
+		heapDown(0);
+	}
+	mNodes[top].heapPosition = InvalidIndex;
+	return top;
+}
+
+void AStarSearch::heapUp(U32 position)
+{
+	const U32 index = mHeap[position];
+	while (position > 0)
+	{
+		const U32 parent = (position - 1) / 2;
+		if (!heapLess(index, mHeap[parent]))
+		{
+			break;
+		}
+		mHeap[position] = mHeap[parent];
+		mNodes[mHeap[position]].heapPosition = position;
+		position = parent;
+	}
+	mHeap[position] = index;
+	mNodes[index].heapPosition = position;
+}
+
+void AStarSearch::heapDown(U32 position)
+{
+	const U32 index = mHeap[position];
+	const U32 size = mHeap.size();
+	while (true)
+	{
+		U32 child = position * 2 + 1;
+		if (child >= size)
+		{
+			break;
+		}
+		if (child + 1 < size && heapLess(mHeap[child + 1], mHeap[child]))
+		{
+			child++;
+		}
+		if (!heapLess(mHeap[child], index))
+		{
+			break;
+		}
+		mHeap[position] = mHeap[child];
+		mNodes[mHeap[position]].heapPosition = position;
+		position = child;
+	}
+	mHeap[position] = index;
+	mNodes[index].heapPosition = position;
+}
+
+bool AStarSearch::heapLess(U32 a, U32 b) const
+{
+	const Node& na = mNodes[a];
+	const Node& nb = mNodes[b];
+	// On ties, prefer the deepest node : it is closer to the end
+	return na.fScore < nb.fScore || (na.fScore == nb.fScore && na.gScore > nb.gScore);
+}
+
+bool AStar::run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, CollisionMatrix& map, bool blockedEnd)
+{
+	return getSearch().run(path, start, end, map, blockedEnd);
+}
+
+bool AStar::canGo(const oe::Vector2i& start, const oe::Vector2i& end, CollisionMatrix& map, bool blockedEnd)
+{
+	return getSearch().canGo(start, end, map, blockedEnd);
+}
+
+void AStar::setConnectivity(const ConnectivityIndex* connectivity)
+{
+	getSearch().setConnectivity(connectivity);
+}
+
+I32 AStar::heuristic(const oe::Vector2i& p1, const oe::Vector2i& p2)
+{
+	I32 dx = p2.x - p1.x;
+	I32 dy = p2.y - p1.y;
+	return (I32)std::sqrt(dx * dx + dy * dy);
+}
+
+I32 AStar::distance(const oe::Vector2i& p1, const oe::Vector2i& p2)
+{
+	// Offset coordinates to axial coordinates
+	const I32 q1 = p1.x - (p1.y - (p1.y & 1)) / 2;
+	const I32 q2 = p2.x - (p2.y - (p2.y & 1)) / 2;
+	const I32 dq = q2 - q1;
+	const I32 dr = p2.y - p1.y;
+	return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+}
+
+const AStarSearch::Stats& AStar::getStats()
+{
+	return getSearch().getStats();
+}
+
+AStarSearch& AStar::getSearch()
+{
+	static AStarSearch search;
+	return search;
+}
+
+RangeSearch::Stats::Stats()
+	: visited(0)
+	, time(oe::Time::Zero)
+	, queries(0)
+{
+}
+
+RangeSearch::RangeSearch()
+	: mVisited()
+	, mFrontier()
+	, mHead(0)
+	, mCount(0)
+	, mStats()
+{
+}
+
+void RangeSearch::run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const CollisionMatrix& map, std::vector<U32>* distances)
+{
+	prepare(map.getSize(), length);
+	search(reachables, start, length, &map, distances);
+}
+
+void RangeSearch::run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const oe::Vector2i& mapSize, std::vector<U32>* distances)
+{
+	prepare(mapSize, length);
+	search(reachables, start, length, nullptr, distances);
+}
+
+const RangeSearch::Stats& RangeSearch::getStats() const
+{
+	return mStats;
+}
+
+void RangeSearch::search(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const CollisionMatrix* map, std::vector<U32>* distances)
+{
+	oe::Clock clock;
+	reachables.clear();
+	if (distances != nullptr)
+	{
+		distances->clear();
+	}
+	mStats.visited = 0;
+	mStats.queries++;
+
+	if (length == 0)
+	{
+		mStats.time = clock.getElapsedTime();
+		return;
+	}
+
+	reachables.push_back(start);
+	if (distances != nullptr)
+	{
+		distances->push_back(0);
+	}
+	if (mVisited.contains(start))
+	{
+		const U32 startIndex = mVisited.toIndex(start);
+		mVisited.set(startIndex, true);
+		push(startIndex, 0);
+	}
+
+	while (mCount > 0)
+	{
+		U32 index, distance;
+		pop(index, distance);
+		if (distance == length)
+		{
+			continue;
+		}
+		for (const oe::Vector2i& neighbor : oe::MapUtility::HexNeighbors(mVisited.toCoords(index)))
+		{
+			if (!mVisited.contains(neighbor) || (map != nullptr && map->get(neighbor)))
+			{
+				continue;
+			}
+			const U32 neighborIndex = mVisited.toIndex(neighbor);
+			if (!mVisited.testAndSet(neighborIndex))
+			{
+				push(neighborIndex, distance + 1);
+				reachables.push_back(neighbor);
+				if (distances != nullptr)
+				{
+					distances->push_back(distance + 1);
+				}
+			}
+		}
+	}
+
+	// Cheaper than clearing the whole map for small ranges
+	for (const oe::Vector2i& coords : reachables)
+	{
+		if (mVisited.contains(coords))
+		{
+			mVisited.set(mVisited.toIndex(coords), false);
+		}
+	}
+	mStats.visited = reachables.size();
+	mStats.time = clock.getElapsedTime();
+}
+
+void RangeSearch::prepare(const oe::Vector2i& size, U32 length)
+{
+	if (mVisited.getSize() != size)
+	{
+		mVisited.create(size, false);
+	}
+
+	// Around walls, the cells at a same number of steps are not on a same ring : a step can hold any cell of the range
+	// The frontier is bounded by the cells in range, 3 * length * (length + 1) + 1, and never more than the map
+	const U64 range = 3ull * length * (length + 1ull) + 1ull;
+	const U64 needed = std::min<U64>(range, mVisited.getCellCount()) + 1;
+	U32 capacity = 16;
+	while (capacity < needed)
+	{
+		capacity <<= 1;
+	}
+	if (mFrontier.size() < capacity)
+	{
+		mFrontier.resize(capacity);
+	}
+	mHead = 0;
+	mCount = 0;
+}
+
+void RangeSearch::push(U32 index, U32 distance)
+{
+	ASSERT(mCount < mFrontier.size());
+	Entry& entry = mFrontier[(mHead + mCount) & (mFrontier.size() - 1)];
+	entry.index = index;
+	entry.distance = distance;
+	mCount++;
+}
+
+void RangeSearch::pop(U32& index, U32& distance)
+{
+	ASSERT(mCount > 0);
+	const Entry& entry = mFrontier[mHead];
+	index = entry.index;
+	distance = entry.distance;
+	mHead = (mHead + 1) & (mFrontier.size() - 1);
+	mCount--;
+}
+
+void Distance::run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const CollisionMatrix& map, std::vector<U32>* distances)
+{
+	getSearch().run(reachables, start, length, map, distances);
+}
+
+void Distance::run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, I32 mapSizeX, I32 mapSizeY)
+{
+	getSearch().run(reachables, start, length, oe::Vector2i(mapSizeX, mapSizeY));
+}
+
+const RangeSearch::Stats& Distance::getStats()
+{
+	return getSearch().getStats();
+}
+
+RangeSearch& Distance::getSearch()
+{
+	static RangeSearch search;
+	return search;
+}
@@ -2,392 +2,190 @@
 #define PATHFINDING_HPP
 
 #include "../Sources/System/MapUtility.hpp"
+#include "../Sources/System/HexGrid.hpp"
+#include "../Sources/System/Time.hpp"
 
-#include <map>
 #include <list>
 
-class Node
-{
-	public:
-		Node() : gScore(0), fScore(0), parent(nullptr), visited(false) {}
-		Node(I32 _gScore, I32 _fScore) : score(_gScore), gScore(_gScore), fScore(_fScore), parent(nullptr), visited(false) {}
-		I32 score;
-		I32 gScore;
-		I32 fScore;
-		oe::Vector2i position;
-		Node* parent;
-		bool visited;
-};
+class ConnectivityIndex;
 
 class CollisionMatrix
 {
     public:
-		CollisionMatrix() {}
-		CollisionMatrix(I32 x, I32 y) { create(x, y); }
-		~CollisionMatrix() { clear(); }
+		CollisionMatrix() : mGrid(), mJournal(JournalSize), mVersion(0), mJournalStart(0) {}
+		CollisionMatrix(I32 x, I32 y) : mGrid(), mJournal(JournalSize), mVersion(0), mJournalStart(0) { create(x, y); }
 
-        void create(I32 x, I32 y)
-		{
-			clear();
-			mSize.set(x, y);
-			for (I32 i = 0; i < x; i++)
-			{
-				for (I32 j = 0; j < y; j++)
-				{
-					mMap[std::pair<I32,I32>(i, j)] = false;
-				}
-			}
-		}
-
-		void clear() { mMap.clear(); }
-
-        bool get(I32 x, I32 y) 
-		{ 
-			auto itr = mMap.find(std::pair<I32, I32>(x, y));
-			if (itr != mMap.end())
-			{
-				return itr->second;
-			}
-			return true;
-		}
-		bool get(const oe::Vector2i& coords) { return get(coords.x, coords.y); }
-
-        void set(I32 x, I32 y, const bool& val) { mMap[std::pair<I32,I32>(x, y)] = val; }
-		void set(const oe::Vector2i& coords, const bool& val) { set(coords.x, coords.y, val); }
-
-		const oe::Vector2i& getSize() const { return mSize; }
-		void setSize(const oe::Vector2i& size)
-		{
-			clear();
-			mSize.set(size);
-		}
+        void create(I32 x, I32 y) { mGrid.create(oe::Vector2i(x, y), false); resetJournal(); }
+
+		void clear() { mGrid.clear(); resetJournal(); }
+
+		// Outside of the map is a wall
+        bool get(I32 x, I32 y) const { return mGrid.get(oe::Vector2i(x, y), true); }
+		bool get(const oe::Vector2i& coords) const { return mGrid.get(coords, true); }
+
+        void set(I32 x, I32 y, const bool& val) { set(oe::Vector2i(x, y), val); }
+		void set(const oe::Vector2i& coords, const bool& val);
+
+		const oe::Vector2i& getSize() const { return mGrid.getSize(); }
+		void setSize(const oe::Vector2i& size) { mGrid.create(size, true); resetJournal(); }
+
+		const oe::HexGrid<bool>& getGrid() const { return mGrid; }
+
+		// Each change increments the version, the last changed cells are kept for incremental planners
+		// Returns false if the changes since this version are not available anymore (too old, or the map has been recreated)
+		U32 getVersion() const { return mVersion; }
+		bool getChanges(U32 version, std::vector<oe::Vector2i>& changes) const;
+
+		// Keep at least size changed cells, the journal never shrinks
+		void reserveJournal(U32 size);
+		U32 getJournalSize() const { return mJournal.size(); }
+
+		static const U32 JournalSize = 256; // Initial size
 
     private:
-        std::map<std::pair<I32,I32>,bool> mMap;
-		oe::Vector2i mSize;
+		void resetJournal();
+
+    private:
+		oe::HexGrid<bool> mGrid;
+		std::vector<oe::Vector2i> mJournal;
+		U32 mVersion;
+		U32 mJournalStart;
 };
 
-class NodeMatrix
+class AStarSearch
 {
 	public:
-		NodeMatrix() {}
-		NodeMatrix(const oe::Vector2i& size) { mSize.set(size); }
-		~NodeMatrix() { clear(); }
-
-		void clear()
+		struct Stats
 		{
-			for (auto itr = mMap.begin(); itr != mMap.end(); ++itr)
-			{
-				delete itr->second;
-			}
-			mMap.clear();
-		}
+			Stats();
+
+			U32 expansions; // Last query
+			oe::Time time; // Last query
+			U32 queries;
+			U64 totalExpansions;
+			oe::Time totalTime;
+		};
+
+		AStarSearch();
+
+		// The end can be a wall only if blockedEnd is true (attack a target, reach an anthill)
+		bool run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, bool blockedEnd = false);
+		bool canGo(const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, bool blockedEnd = false);
 
-		Node* get(I32 x, I32 y) { return mMap.find(std::pair<I32, I32>(x, y))->second; }
-		Node* get(const oe::Vector2i& coords) { return get(coords.x, coords.y); }
+		// Used to reject unreachable ends without searching, it must be up to date with the map given to the queries
+		void setConnectivity(const ConnectivityIndex* connectivity);
 
-		void set(I32 x, I32 y, Node* node) { mMap[std::pair<I32, I32>(x, y)] = node; }
-		void set(const oe::Vector2i& coords, Node* node) { set(coords.x, coords.y, node); }
+		const Stats& getStats() const;
+		void resetStats();
 
-		const oe::Vector2i& getSize() const { return mSize; }
+	private:
+		bool search(const oe::Vector2i& start, const oe::Vector2i& end, const CollisionMatrix& map, bool blockedEnd);
+		bool expand(const oe::Vector2i& end, const CollisionMatrix& map);
+
+		void prepare(const oe::Vector2i& size);
+		void open(U32 index, I32 gScore, I32 fScore, U32 parent);
+
+		void heapPush(U32 index);
+		U32 heapPop();
+		void heapUp(U32 position);
+		void heapDown(U32 position);
+		bool heapLess(U32 a, U32 b) const;
 
 	private:
-		std::map<std::pair<I32, I32>, Node*> mMap;
-		oe::Vector2i mSize;
+		static const U32 InvalidIndex = 0xFFFFFFFF;
+
+		// Nodes are only valid when their generation is the current one, and closed when closedGeneration is
+		struct Node
+		{
+			U32 generation;
+			U32 closedGeneration;
+			I32 gScore;
+			I32 fScore;
+			U32 parent;
+			U32 heapPosition;
+		};
+
+		oe::HexGrid<Node> mNodes;
+		std::vector<U32> mHeap;
+		U32 mGeneration;
+		const ConnectivityIndex* mConnectivity;
+		Stats mStats;
 };
 
 class AStar
 {
 	public:
-		static bool run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, CollisionMatrix& map)
-		{
-			path.clear();
-
-			if (start == end || start.x < 0 || start.y < 0)
-			{
-				return false;
-			}
-
-			oe::Vector2i size(map.getSize());
-
-			NodeMatrix closeList(size);
-			std::list<Node*> openList;
-
-			// RESET
-			for (I32 i = 0; i < size.x; i++)
-			{
-				for (I32 j = 0; j < size.y; j++)
-				{
-					closeList.set(i, j, new Node((map.get(i, j)) ? 1 : 0, 0));
-				}
-			}
-
-			//VERIF
-			if (isWall(end, closeList))
-			{
-				return false;
-			}
-
-			// FIRST NODE
-			Node* n = closeList.get(start);
-			n->position.set(start);
-			n->gScore = 0;
-			n->fScore = n->gScore + heuristic(start, end);
-
-			openList.push_front(n);
-
-			while (!openList.empty())
-			{
-				openList.sort(compareNode);
-				Node* current = openList.front(); // Take the most interesting node
-
-				if (current->position == end) // Check if we are the end
-				{
-                    Node* nend = closeList.get(end);
-                    while (nend != nullptr)
-                    {
-						if (nend->parent != nullptr)
-						{
-							path.emplace_front(nend->position);
-						}
-                        nend = nend->parent;
-                    }
-					return true;
-				}
-
-				// If the end wasn't reached
-
-				std::list<Node*> neighbors;
-				getNeighbors(neighbors, current, closeList);
-
-				openList.pop_front();
-				current->visited = true; // add to closed list
-
-				while (!neighbors.empty())
-				{
-					Node* neighbor = neighbors.front();
-					neighbors.pop_front();
-					if (!neighbor->visited) // If not in the closed list
-					{
-						I32 gscore = current->gScore + current->score;
-						if (!isInOpenList(neighbor, openList) || gscore < neighbor->gScore)
-						{
-							neighbor->parent = current;
-							neighbor->gScore = gscore;
-							neighbor->fScore = neighbor->gScore + heuristic(neighbor->position, end);
-							if (!isInOpenList(neighbor, openList))
-							{
-								openList.push_front(neighbor);
-							}
-						}
-					}
-				}
-			}
-			return false;
-		}
-
-		static bool canGo(const oe::Vector2i& start, const oe::Vector2i& end, CollisionMatrix& map)
-		{
-			oe::Vector2i size(map.getSize());
-			NodeMatrix closeList(size);
-			std::list<Node*> openList;
-			for (I32 i = 0; i < size.x; i++)
-			{
-				for (I32 j = 0; j < size.y; j++)
-				{
-					closeList.set(i, j, new Node((map.get(i, j)) ? 1 : 0, 0));
-				}
-			}
-			Node* n = closeList.get(start);
-			n->position.set(start);
-			n->gScore = 0;
-			n->fScore = n->gScore + heuristic(start, end);
-			openList.push_front(n);
-			while (!openList.empty())
-			{
-				openList.sort(compareNode);
-				Node* current = openList.front(); // Take the most interesting node
-
-				if (current->position == end) // Check if we are the end
-				{
-					return true;
-				}
-
-				// If the end wasn't reached
-
-				std::list<Node*> neighbors;
-				getNeighbors(neighbors, current, closeList);
-
-				openList.pop_front();
-				current->visited = true; // add to closed list
-
-				while (!neighbors.empty())
-				{
-					Node* neighbor = neighbors.front();
-					neighbors.pop_front();
-					if (!neighbor->visited) // If not in the closed list
-					{
-						I32 gscore = current->gScore + current->score;
-						if (!isInOpenList(neighbor, openList) || gscore < neighbor->gScore)
-						{
-							neighbor->parent = current;
-							neighbor->gScore = gscore;
-							neighbor->fScore = neighbor->gScore + heuristic(neighbor->position, end);
-							if (!isInOpenList(neighbor, openList))
-							{
-								openList.push_front(neighbor);
-							}
-						}
-					}
-				}
-			}
-			return false;
-		}
-
-		static I32 heuristic(const oe::Vector2i& p1, const oe::Vector2i& p2)
-		{
-			I32 dx = p2.x - p1.x;
-			I32 dy = p2.y - p1.y;
-			return (I32)std::sqrt(dx * dx + dy * dy);
-		}
+		static bool run(std::list<oe::Vector2i>& path, const oe::Vector2i& start, const oe::Vector2i& end, CollisionMatrix& map, bool blockedEnd = false);
+		static bool canGo(const oe::Vector2i& start, const oe::Vector2i& end, CollisionMatrix& map, bool blockedEnd = false);
+		static void setConnectivity(const ConnectivityIndex* connectivity);
+
+		static I32 heuristic(const oe::Vector2i& p1, const oe::Vector2i& p2);
+
+		// Number of steps between two cells of the hexagonal map (pointy, odd stagger index)
+		static I32 distance(const oe::Vector2i& p1, const oe::Vector2i& p2);
+
+		static const AStarSearch::Stats& getStats();
 
 	private:
-		static bool isInOpenList(const Node* n, std::list<Node*>& openList) // Check if the node is in the openlist
-		{
-			std::list<Node*>::iterator end(openList.end());
-			return std::find(openList.begin(), end, n) != end;
-		}
+		static AStarSearch& getSearch();
+};
 
-		static bool isVisited(const oe::Vector2i& position, NodeMatrix& closeList) // Return if the position in the map has already been visited
+// Cells reachable from a start in a number of steps, with a breadth-first search
+// Visited cells are kept in a bitset and the frontier in a ring buffer, the memory is reused between queries
+class RangeSearch
+{
+	public:
+		struct Stats
 		{
-			return closeList.get(position)->visited;
-		}
+			Stats();
 
-		static bool isWall(const oe::Vector2i& position, NodeMatrix& closeList) // Return if the point at this position is a wall
-		{
-			return closeList.get(position)->gScore == 1;// 1 = collision
-		}
+			U32 visited; // Last query
+			oe::Time time; // Last query
+			U32 queries;
+		};
 
-		static void getNeighbors(std::list<Node*>& neighbors, const Node* node, NodeMatrix& closeList) // Get neighbors nodes of a node (point)
-		{
-			std::vector<oe::Vector2i> positionsNeighbors;
-			oe::MapUtility::getNeighboors(positionsNeighbors, node->position, oe::MapUtility::Orientation::Hexagonal);
-
-			for (oe::Vector2i& p : positionsNeighbors)
-			{
-				if (p.x >= 0 && p.y >= 0 && p.x < closeList.getSize().x && p.y < closeList.getSize().y)
-				{
-					Node* newnode = closeList.get(p);
-					newnode->position.set(p);
-					if (!isWall(newnode->position, closeList))
-					{
-						neighbors.push_back(newnode);
-					}
-				}
-			}
-		}
-
-		static bool compareNode(const Node* first, const Node* second)
+		RangeSearch();
+
+		// The start is always reachable even if it is a wall (the cell of an ant), walls are not crossed
+		// The distance of each reachable cell is given in the same order if distances is not null
+		void run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const CollisionMatrix& map, std::vector<U32>* distances = nullptr);
+
+		// Every cell of the map is free
+		void run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const oe::Vector2i& mapSize, std::vector<U32>* distances = nullptr);
+
+		const Stats& getStats() const;
+
+	private:
+		void search(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const CollisionMatrix* map, std::vector<U32>* distances);
+
+		void prepare(const oe::Vector2i& size, U32 length);
+		void push(U32 index, U32 distance);
+		void pop(U32& index, U32& distance);
+
+	private:
+		struct Entry
 		{
-			return first->fScore < second->fScore;
-		}
+			U32 index;
+			U32 distance;
+		};
+
+		oe::HexGrid<bool> mVisited; // Only the visited cells are cleared after a query
+		std::vector<Entry> mFrontier; // Ring buffer, the size is a power of two
+		U32 mHead;
+		U32 mCount;
+		Stats mStats;
 };
 
 class Distance
 {
-    public:
-		static void run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, CollisionMatrix& map)
-		{
-			reachables.clear();
-
-			if (length == 0)
-			{
-				return;
-			}
-
-			std::vector<oe::Vector2i> neighbors;
-			std::vector<oe::Vector2i> checks;
-			std::vector<oe::Vector2i> futurChecks;
-
-			reachables.push_back(start);
-			checks.push_back(start);
-
-			for (U32 i = 0; i < length; i++)
-			{
-				for (const oe::Vector2i& check : checks)
-				{
-					neighbors.clear();
-					oe::MapUtility::getNeighboors(neighbors, check, oe::MapUtility::Orientation::Hexagonal);
-					for (const oe::Vector2i& neighbor : neighbors)
-					{
-						if (!has(neighbor, reachables) && map.get(neighbor) != 1) // isnt a wall
-						{
-							reachables.emplace_back(neighbor);
-							futurChecks.emplace_back(neighbor);
-						}
-					}
-				}
-				checks.clear();
-				for (const oe::Vector2i& check : futurChecks)
-				{
-					checks.emplace_back(check);
-				}
-				futurChecks.clear();
-			}
-		}
-
-		static void run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, I32 mapSizeX, I32 mapSizeY)
-		{
-			reachables.clear();
-
-			if (length == 0)
-			{
-				return;
-			}
-
-			std::vector<oe::Vector2i> neighbors;
-			std::vector<oe::Vector2i> checks;
-			std::vector<oe::Vector2i> futurChecks;
-
-			reachables.push_back(start);
-			checks.push_back(start);
-
-			for (U32 i = 0; i < length; i++)
-			{
-				for (const oe::Vector2i& check : checks)
-				{
-					neighbors.clear();
-					oe::MapUtility::getNeighboors(neighbors, check, oe::MapUtility::Orientation::Hexagonal);
-					for (const oe::Vector2i& neighbor : neighbors)
-					{
-						if (neighbor.x < mapSizeX && neighbor.y < mapSizeY && !has(neighbor, reachables))
-						{
-							reachables.emplace_back(neighbor);
-							futurChecks.emplace_back(neighbor);
-						}
-					}
-				}
-				checks.clear();
-				for (const oe::Vector2i& check : futurChecks)
-				{
-					checks.emplace_back(check);
-				}
-				futurChecks.clear();
-			}
-		}
+	public:
+		static void run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, const CollisionMatrix& map, std::vector<U32>* distances = nullptr);
+		static void run(std::vector<oe::Vector2i>& reachables, const oe::Vector2i& start, U32 length, I32 mapSizeX, I32 mapSizeY);
+
+		static const RangeSearch::Stats& getStats();
 
 	private:
-		static bool has(const oe::Vector2i& value, std::vector<oe::Vector2i>& in)
-		{
-			for (const oe::Vector2i& v : in)
-			{
-				if (value == v)
-				{
-					return true;
-				}
-			}
-			return false;
-		}
+		static RangeSearch& getSearch();
 };
 
 #endif // PATHFINDING_HPP
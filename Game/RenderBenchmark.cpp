@@ -0,0 +1,129 @@
+#include "RenderBenchmark.hpp"
+
+#include "../Sources/Core/World.hpp"
+#include "../Sources/Core/Components/SpriteComponent.hpp"
+#include "../Sources/Math/Random.hpp"
+#include "../Sources/System/Log.hpp"
+#include "../Sources/System/String.hpp"
+
+#include <algorithm>
+
+const U32 RenderBenchmark::Frames;
+const U32 RenderBenchmark::ZLevels;
+
+namespace
+{
+
+// A sprite walking on the map
+class BenchSprite : public oe::Entity
+{
+	OeEntity(BenchSprite, oe::Entity)
+
+	public:
+		BenchSprite(oe::World& world)
+			: oe::Entity(world)
+			, mSprite(*this)
+		{
+			mSprite.setTextureRect(sf::IntRect(0, 0, 60, 52));
+		}
+
+		oe::SpriteComponent& getSprite()
+		{
+			return mSprite;
+		}
+
+	private:
+		oe::SpriteComponent mSprite;
+};
+
+// Same order as a sort of every renderable by (z, y)
+bool isSorted(const oe::RenderOrder& order, U32 expectedCount)
+{
+	U32 count = 0;
+	U64 previous = 0;
+	for (const oe::RenderableComponent* renderable : order)
+	{
+		if (renderable == nullptr)
+		{
+			return false;
+		}
+		const U64 key = oe::RenderOrder::computeKey(renderable->getGlobalZ(), renderable->getGlobalPosition().y);
+		if (count > 0 && key < previous)
+		{
+			return false;
+		}
+		previous = key;
+		count++;
+	}
+	return count == expectedCount;
+}
+
+} // namespace
+
+void RenderBenchmark::run(oe::Application& application, U32 sprites, U32 movedPercent)
+{
+	oe::World world(application);
+	std::vector<oe::EntityHandle> handles;
+	std::vector<BenchSprite*> entities;
+	handles.reserve(sprites);
+	entities.reserve(sprites);
+	for (U32 i = 0; i < sprites; i++)
+	{
+		oe::EntityHandle handle = world.createEntity<BenchSprite>();
+		BenchSprite* entity = handle.getAs<BenchSprite>();
+		entity->setPosition(oe::Random::get<F32>(0.0f, 2000.0f), oe::Random::get<F32>(0.0f, 2000.0f));
+		entity->getSprite().setPositionZ(static_cast<F32>(i % ZLevels));
+		handles.push_back(handle);
+		entities.push_back(entity);
+	}
+
+	// Spawned and registered in the render system : the first update sorts everything
+	world.update();
+	oe::RenderSystem& renderSystem = world.getRenderSystem();
+	oe::Clock clock;
+	renderSystem.updateOrder();
+	const oe::Time firstTime = clock.getElapsedTime();
+	U32 errors = isSorted(renderSystem.getOrder(), sprites) ? 0 : 1;
+
+	// Each frame, a share of the sprites walks by a few pixels
+	const U32 moved = sprites * std::min(movedPercent, 100U) / 100;
+	oe::Time time;
+	oe::Time worstTime;
+	for (U32 frame = 0; frame < Frames; frame++)
+	{
+		const U32 first = (sprites > 0) ? oe::Random::get<U32>(0, sprites - 1) : 0;
+		for (U32 i = 0; i < moved; i++)
+		{
+			entities[(first + i) % sprites]->move(oe::Random::get<F32>(-2.0f, 2.0f), oe::Random::get<F32>(-4.0f, 4.0f));
+		}
+
+		clock.restart();
+		renderSystem.updateOrder();
+		const oe::Time frameTime = clock.getElapsedTime();
+		time = time + frameTime;
+		if (frameTime > worstTime)
+		{
+			worstTime = frameTime;
+		}
+
+		if (!isSorted(renderSystem.getOrder(), sprites))
+		{
+			errors++;
+		}
+	}
+
+	oe::info(oe::toString(sprites) + " sprites on " + oe::toString(ZLevels) + " z levels, " + oe::toString(moved) + " moved per frame, " + oe::toString(Frames) + " frames");
+	oe::info("  First sort " + oe::toString(firstTime.asMicroseconds()) + "us");
+	oe::info("  Update " + oe::toString(time.asMicroseconds() / Frames) + "us per frame, worst " + oe::toString(worstTime.asMicroseconds()) + "us");
+	if (errors > 0)
+	{
+		oe::error("  Order differs from the sort by (z, y) after " + oe::toString(errors) + " updates");
+	}
+	else
+	{
+		oe::info("  Order matches the sort by (z, y) after every update");
+	}
+
+	world.killEntities(handles.data(), handles.size());
+	world.update();
+}
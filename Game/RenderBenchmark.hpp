@@ -0,0 +1,18 @@
+#ifndef RENDERBENCHMARK_HPP
+#define RENDERBENCHMARK_HPP
+
+#include "../Sources/Core/Application.hpp"
+
+// Incremental render order of the RenderSystem with many moving sprites, the results are written in the log
+// Run with : Arthropoda --benchrender [sprites [moved percent]]
+class RenderBenchmark
+{
+	public:
+		static void run(oe::Application& application, U32 sprites, U32 movedPercent);
+
+	private:
+		static const U32 Frames = 200;
+		static const U32 ZLevels = 4; // Ground, units, life bars and resources
+};
+
+#endif // RENDERBENCHMARK_HPP
@@ -5,6 +5,8 @@
 
 class Resource : public MapEntity
 {
+	OeEntity(Resource, MapEntity)
+
 	public:
 		Resource(oe::World& world);
 
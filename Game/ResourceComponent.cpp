@@ -11,8 +11,12 @@ ResourceComponent::ResourceComponent(oe::Entity& entity)
 	mText.setFillColor(sf::Color::White);
 	mText.setOutlineColor(sf::Color::Black);
 	mText.setOutlineThickness(1.f);
-	mText.setFont(getWorld().getFonts().get(GameSingleton::sansationFont));
 	mText.setCharacterSize(12);
+	// Fonts are not loaded in headless mode : the text keeps its string and draws nothing
+	if (!getWorld().getApplication().isHeadless())
+	{
+		mText.setFont(getWorld().getFonts().get(GameSingleton::sansationFont));
+	}
 }
 
 void ResourceComponent::setResourcesMax(U32 max)
@@ -49,4 +53,6 @@ void ResourceComponent::updateText()
 	{
 		mText.setString("");
 	}
+	mLocalAABB = mText.getLocalBounds();
+	invalidateLocalAABB();
 }
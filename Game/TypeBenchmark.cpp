@@ -0,0 +1,119 @@
+#include "TypeBenchmark.hpp"
+
+#include "../Sources/Core/World.hpp"
+#include "../Sources/System/Log.hpp"
+#include "../Sources/System/String.hpp"
+
+// Same hierarchy as Ant, Resource and Anthill under MapEntity, without the map, the textures and the font they need
+namespace
+{
+
+class BenchMapEntity : public oe::Entity
+{
+	OeEntity(BenchMapEntity, oe::Entity)
+
+	public:
+		BenchMapEntity(oe::World& world) : oe::Entity(world) {}
+};
+
+class BenchAnt : public BenchMapEntity
+{
+	OeEntity(BenchAnt, BenchMapEntity)
+
+	public:
+		BenchAnt(oe::World& world) : BenchMapEntity(world) {}
+};
+
+class BenchResource : public BenchMapEntity
+{
+	OeEntity(BenchResource, BenchMapEntity)
+
+	public:
+		BenchResource(oe::World& world) : BenchMapEntity(world) {}
+};
+
+class BenchAnthill : public BenchMapEntity
+{
+	OeEntity(BenchAnthill, BenchMapEntity)
+
+	public:
+		BenchAnthill(oe::World& world) : BenchMapEntity(world) {}
+};
+
+} // namespace
+
+const U32 TypeBenchmark::EntityCount;
+
+void TypeBenchmark::run(oe::Application& application, U32 passes)
+{
+	oe::World world(application);
+	std::vector<oe::EntityHandle> handles;
+	handles.reserve(EntityCount);
+	for (U32 i = 0; i < EntityCount; i++)
+	{
+		switch (i % 3)
+		{
+			case 0: handles.push_back(world.createEntity<BenchAnt>()); break;
+			case 1: handles.push_back(world.createEntity<BenchResource>()); break;
+			default: handles.push_back(world.createEntity<BenchAnthill>()); break;
+		}
+	}
+
+	// Both give the same answer, base classes included
+	U32 mismatches = 0;
+	for (const oe::EntityHandle& handle : handles)
+	{
+		oe::Entity* entity = handle.get();
+		mismatches += ((handle.getAs<BenchAnt>() != nullptr) != (fast_dynamic_cast<BenchAnt*>(entity) != nullptr)) ? 1 : 0;
+		mismatches += ((handle.getAs<BenchResource>() != nullptr) != (fast_dynamic_cast<BenchResource*>(entity) != nullptr)) ? 1 : 0;
+		mismatches += ((handle.getAs<BenchMapEntity>() != nullptr) != (fast_dynamic_cast<BenchMapEntity*>(entity) != nullptr)) ? 1 : 0;
+	}
+	if (mismatches > 0)
+	{
+		oe::error("Types : " + oe::toString(mismatches) + " casts differ between getAs and fast_dynamic_cast");
+	}
+
+	// Two casts per entity, as in the game : the type of the unit and its map entity base
+	// The counts are logged so that no loop can be removed
+	oe::Clock clock;
+	U64 counts[3] = { 0, 0, 0 };
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (const oe::EntityHandle& handle : handles)
+		{
+			counts[0] += (handle.getAs<BenchAnt>() != nullptr) ? 1 : 0;
+			counts[0] += (handle.getAs<BenchMapEntity>() != nullptr) ? 1 : 0;
+		}
+	}
+	const oe::Time typeIdTime = clock.restart();
+
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (const oe::EntityHandle& handle : handles)
+		{
+			oe::Entity* entity = handle.get();
+			counts[1] += (fast_dynamic_cast<BenchAnt*>(entity) != nullptr) ? 1 : 0;
+			counts[1] += (fast_dynamic_cast<BenchMapEntity*>(entity) != nullptr) ? 1 : 0;
+		}
+	}
+	const oe::Time dynamicCastTime = clock.restart();
+
+	// Only the lookup of the handle
+	for (U32 pass = 0; pass < passes; pass++)
+	{
+		for (const oe::EntityHandle& handle : handles)
+		{
+			counts[2] += (handle.get() != nullptr) ? 1 : 0;
+		}
+	}
+	const oe::Time lookupTime = clock.restart();
+
+	const F32 casts = static_cast<F32>(passes) * EntityCount * 2;
+	oe::info(oe::toString(EntityCount) + " entities, " + oe::toString(passes) + " passes, 2 casts per entity");
+	oe::info("  getAs by type id " + oe::toString(typeIdTime.asMilliseconds()) + "ms, " + oe::toString(typeIdTime.asMicroseconds() * 1000.0f / casts) + "ns per cast (count " + oe::toString(counts[0]) + ")");
+	oe::info("  fast_dynamic_cast " + oe::toString(dynamicCastTime.asMilliseconds()) + "ms, " + oe::toString(dynamicCastTime.asMicroseconds() * 1000.0f / casts) + "ns per cast (count " + oe::toString(counts[1]) + ")");
+	oe::info("  handle lookup only " + oe::toString(lookupTime.asMilliseconds()) + "ms (count " + oe::toString(counts[2]) + ")");
+
+	world.killEntities(handles.data(), handles.size());
+	world.update();
+}
@@ -0,0 +1,17 @@
+#ifndef TYPEBENCHMARK_HPP
+#define TYPEBENCHMARK_HPP
+
+#include "../Sources/Core/Application.hpp"
+
+// EntityHandle::getAs<T> with the type ids against fast_dynamic_cast, the results are written in the log
+// Run with : Arthropoda --benchtypes [passes]
+class TypeBenchmark
+{
+	public:
+		static void run(oe::Application& application, U32 passes);
+
+	private:
+		static const U32 EntityCount = 1024; // Stand-ins for ants, resources and anthills in turn
+};
+
+#endif // TYPEBENCHMARK_HPP
@@ -6,20 +6,91 @@
 #include "GameState.hpp"
 #include "IntroState.hpp"
 #include "MenuState.hpp"
+#include "PathBenchmark.hpp"
+#include "RenderBenchmark.hpp"
+#include "TypeBenchmark.hpp"
 
-int main()
+#include <cstdlib>
+
+// Usage : Arthropoda [--headless [matches [seed]] [--cooperative]] [--benchpath [queries [seed]]] [--benchtypes [passes]] [--benchrender [sprites [moved percent]]]
+// Headless : AI against AI, without window, rendering or audio, as fast as possible
+// The same seed always plays the same matches
+// Cooperative : both AIs plan their whole turn at once (see AI::setCooperative)
+// Benchpath : HPAStar against AStar::run on random 256x256 and 1024x1024 maps, then the ways to iterate hexagonal neighbors
+// Benchtypes : EntityHandle::getAs against fast_dynamic_cast on entities shaped like ants, resources and anthills
+// Benchrender : render order updates while a share of the sprites moves each frame
+int main(int argc, char** argv)
 {
-	oe::Application application;
+	if (argc > 1 && std::string(argv[1]) == "--benchpath")
+	{
+		if (argc > 3)
+		{
+			oe::Random::setSeed(argv[3]);
+		}
+		PathBenchmark::run((argc > 2) ? static_cast<U32>(std::atoi(argv[2])) : 100);
+		oe::info("Seed " + oe::Random::getSeed());
+		return 0;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--benchtypes")
+	{
+		oe::Application application(true);
+		TypeBenchmark::run(application, (argc > 2) ? static_cast<U32>(std::atoi(argv[2])) : 20000);
+		return 0;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--benchrender")
+	{
+		oe::Application application(true);
+		const U32 sprites = (argc > 2) ? static_cast<U32>(std::atoi(argv[2])) : 10000;
+		RenderBenchmark::run(application, sprites, (argc > 3) ? static_cast<U32>(std::atoi(argv[3])) : 5);
+		return 0;
+	}
+
+	bool headless = (argc > 1 && std::string(argv[1]) == "--headless");
+	bool cooperative = (headless && std::string(argv[argc - 1]) == "--cooperative"); // Always the last argument
+	I32 headlessArgs = (cooperative) ? argc - 1 : argc;
+	U32 matches = (headless && headlessArgs > 2) ? static_cast<U32>(std::atoi(argv[2])) : 1;
+	if (headless && headlessArgs > 3)
+	{
+		oe::Random::setSeed(argv[3]);
+	}
+	if (cooperative)
+	{
+		GameSingleton::cooperative = true;
+	}
+
+	oe::Application application(headless);
+	application.setUpdateRate(UPDATERATE);
+	application.setRenderRate(RENDERRATE);
 
 	// Load Resources
 	GameSingleton::win = false;
+	GameSingleton::movementSound = application.getAudio().createSound("movement", "Assets/movement.wav");
+	GameSingleton::actionSound = application.getAudio().createSound("action", "Assets/action.wav");
+	GameSingleton::attackSound = application.getAudio().createSound("attack", "Assets/attack.wav");
+
+	if (headless)
+	{
+		GameSingleton::loadTileset(false);
+
+		oe::Clock clock;
+		U32 wins = 0;
+		for (U32 i = 0; i < matches; i++)
+		{
+			application.pushState<GameState>();
+			application.run();
+			wins += (GameSingleton::win) ? 1 : 0;
+		}
+		oe::info("Seed " + oe::Random::getSeed());
+		oe::info(oe::toString(matches) + " matches in " + oe::toString(clock.getElapsedTime().asSeconds()) + "s, player 1 won " + oe::toString(wins) + ((GameSingleton::cooperative) ? ", cooperative AIs" : ""));
+		return 0;
+	}
+
 	GameSingleton::loadTileset();
 	GameSingleton::antTexture = application.getTextures().create("ants", "Assets/pions.png");
 	GameSingleton::objectsTexture = application.getTextures().create("objects", "Assets/objects.png");
 	GameSingleton::sansationFont = application.getFonts().create("sansation", "Assets/sansation.ttf");
-	GameSingleton::movementSound = application.getAudio().createSound("movement", "Assets/movement.wav");
-	GameSingleton::actionSound = application.getAudio().createSound("action", "Assets/action.wav");
-	GameSingleton::attackSound = application.getAudio().createSound("attack", "Assets/attack.wav");
 
 	// Load Window
 	oe::Window& window = application.getWindow();
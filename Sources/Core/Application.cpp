@@ -5,8 +5,11 @@
 namespace oe
 {
 
-Application::Application()
+Application::Application(bool headless)
 	: mLog()
+	, mFrameAllocator(new FrameAllocator())
+	, mProfiler()
+	, mJobSystem()
 	, mWindow()
 	, mStates(*this)
 	, mLocalization()
@@ -16,9 +19,20 @@ Application::Application()
 	, mFPSCounter(0)
 	, mUPSCounter(0)
 	, mRunning(true)
+	, mHeadless(headless)
+	, mTimePerUpdate(seconds(1.f / 60.f))
+	, mTimePerRender(Time::Zero)
+	, mInterpolation(0.0f)
 {
 	mWindowClosedSlot.connect(mWindow.onWindowClosed, [this](const Window* window) { stop(); });
 
+	mJobSystem.start();
+
+	if (mHeadless)
+	{
+		mAudioSystem.setEnabled(false);
+	}
+
 	//ImGui::SFML::Init(mWindow.getHandle());
 }
 
@@ -31,6 +45,9 @@ Application::~Application()
 
 	getAudio().stop();
 
+	// Used to size the frame allocator
+	info("Frame allocator : peak " + toString(mFrameAllocator->getPeakUsage()) + " / " + toString(mFrameAllocator->getMaxSize()) + " bytes, " + toString(mFrameAllocator->getOverflowCount()) + " overflows");
+
 	//ImGui::SFML::Shutdown();
 
 	#ifdef OE_PLATFORM_ANDROID
@@ -38,13 +55,26 @@ Application::~Application()
 	#endif
 }
 
+bool Application::isHeadless() const
+{
+	return mHeadless;
+}
+
 void Application::run()
 {
+	mRunning = true;
+	if (mHeadless)
+	{
+		runHeadless();
+		return;
+	}
+
 	Clock clock;
 	Clock clockFPS;
 	Clock clockUPS;
-	Time timePerFrame(seconds(1.f / 60.f));
-	Time timeSinceLastUpdate(Time::Zero);
+	Time accumulator(Time::Zero);
+	Time timeSinceLastRender(Time::Zero);
+	Time maxFrameTime(seconds(0.25f));
 	Time second(seconds(1.f));
 	U32 tempFPS = 0;
 	mFPSCounter = 0;
@@ -52,17 +82,27 @@ void Application::run()
 	mUPSCounter = 0;
 	while (mRunning)
 	{
+		// Scratch memory of the frame before the last one is released
+		mFrameAllocator->swap();
+		ProfileCounter("FrameAllocator::usage", mFrameAllocator->getFrameUsage());
+
+		// A long frame (loading, breakpoint) is not caught up entirely
 		Time dt = clock.restart();
-		timeSinceLastUpdate += dt;
-		if (timeSinceLastUpdate >= timePerFrame)
+		if (dt > maxFrameTime)
 		{
-			timeSinceLastUpdate = oe::Time::Zero;
+			dt = maxFrameTime;
+		}
+		accumulator += dt;
+		timeSinceLastRender += dt;
 
-			// Handle event
-			processEvents();
+		// Handle event
+		processEvents();
 
-			// Update
-			update(timePerFrame);
+		// Update : always with the same time step, as many times as needed
+		while (accumulator >= mTimePerUpdate && mRunning)
+		{
+			update(mTimePerUpdate);
+			accumulator -= mTimePerUpdate;
 
 			// UPS
 			tempUPS++;
@@ -75,6 +115,19 @@ void Application::run()
 		}
 
 		// Render
+		if (timeSinceLastRender < mTimePerRender)
+		{
+			// Nothing to do until the next update or render
+			Time wait(mTimePerRender - timeSinceLastRender);
+			if (mTimePerUpdate - accumulator < wait)
+			{
+				wait = mTimePerUpdate - accumulator;
+			}
+			Thread::sleep(wait);
+			continue;
+		}
+		timeSinceLastRender = Time::Zero;
+		mInterpolation = accumulator.asSeconds() / mTimePerUpdate.asSeconds();
 		render();
 
 		// FPS
@@ -94,6 +147,32 @@ void Application::stop()
 	getAudio().stop();
 }
 
+void Application::setUpdateRate(F32 updatesPerSecond)
+{
+	ASSERT(updatesPerSecond > 0.0f);
+	mTimePerUpdate = seconds(1.f / updatesPerSecond);
+}
+
+void Application::setRenderRate(F32 framesPerSecond)
+{
+	mTimePerRender = (framesPerSecond > 0.0f) ? seconds(1.f / framesPerSecond) : Time::Zero;
+}
+
+Time Application::getTimePerUpdate() const
+{
+	return mTimePerUpdate;
+}
+
+Time Application::getTimePerRender() const
+{
+	return mTimePerRender;
+}
+
+F32 Application::getInterpolation() const
+{
+	return mInterpolation;
+}
+
 void Application::popState()
 {
 	mStates.popState();
@@ -119,6 +198,21 @@ AudioSystem& Application::getAudio()
 	return mAudioSystem;
 }
 
+FrameAllocator& Application::getFrameAllocator()
+{
+	return *mFrameAllocator;
+}
+
+Profiler& Application::getProfiler()
+{
+	return mProfiler;
+}
+
+JobSystem& Application::getJobSystem()
+{
+	return mJobSystem;
+}
+
 const U32& Application::getFPSCount() const
 {
 	return mFPSCounter;
@@ -164,6 +258,37 @@ void Application::render()
 	mWindow.display();
 }
 
+void Application::runHeadless()
+{
+	// Same time step as the windowed loop, without waiting for it
+	Clock clockUPS;
+	Time second(seconds(1.f));
+	U32 tempUPS = 0;
+	mUPSCounter = 0;
+	while (mRunning)
+	{
+		mFrameAllocator->swap();
+		ProfileCounter("FrameAllocator::usage", mFrameAllocator->getFrameUsage());
+
+		update(mTimePerUpdate);
+
+		// Nothing left to simulate
+		if (mStates.getStateCount() == 0)
+		{
+			stop();
+		}
+
+		// UPS
+		tempUPS++;
+		if (clockUPS.getElapsedTime() >= second)
+		{
+			clockUPS.restart();
+			mUPSCounter = tempUPS;
+			tempUPS = 0;
+		}
+	}
+}
+
 Window& Application::getWindow()
 {
 	return mWindow;
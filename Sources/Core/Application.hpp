@@ -10,27 +10,44 @@
 #include "../System/Localization.hpp"
 #include "../System/ResourceHolder.hpp"
 #include "../System/SFMLResources.hpp"
+#include "../System/JobSystem.hpp"
+#include "../System/Profiler.hpp"
+#include "../System/StackAllocator.hpp"
 
 #include "Systems/AudioSystem.hpp"
 
 #include "../ExtLibs/imgui/imgui.h"
 #include "../ExtLibs/imgui/imgui-SFML.h"
 
+#include <memory>
+
 namespace oe
 {
 
 class Application
 {
 	public:
-		Application();
+		// Headless : no window, no rendering and no audio, updated with a fixed time step as fast as possible
+		Application(bool headless = false);
 		~Application();
 
+		bool isHeadless() const;
+
 		Window& getWindow();
 		Localization& getLocalization();
 
 		void run();
 		void stop();
 
+		// The simulation runs at a fixed rate, the rendering as fast as possible (0) or at its own rate
+		void setUpdateRate(F32 updatesPerSecond);
+		void setRenderRate(F32 framesPerSecond);
+		Time getTimePerUpdate() const;
+		Time getTimePerRender() const;
+
+		// Time since the last update divided by the update time, in [0, 1), used to draw between two updates
+		F32 getInterpolation() const;
+
 		template <typename T, typename ... Args>
 		void pushState(Args&& ... args);
 		void popState();
@@ -39,6 +56,9 @@ class Application
 		TextureHolder& getTextures();
 		FontHolder& getFonts();
 		AudioSystem& getAudio();
+		FrameAllocator& getFrameAllocator();
+		Profiler& getProfiler();
+		JobSystem& getJobSystem();
 
 		const U32& getFPSCount() const;
 		const U32& getUPSCount() const;
@@ -49,9 +69,13 @@ class Application
 		void processEvents();
 		void update(Time dt);
 		void render();
+		void runHeadless();
 
 	private:
 		Log mLog;
+		std::unique_ptr<FrameAllocator> mFrameAllocator; // On the heap : the two frame stacks are too large for the stack of main
+		Profiler mProfiler;
+		JobSystem mJobSystem;
 		Window mWindow;
 		StateManager mStates;
 		Localization mLocalization;
@@ -61,6 +85,10 @@ class Application
 		U32 mFPSCounter;
 		U32 mUPSCounter;
 		bool mRunning;
+		bool mHeadless;
+		Time mTimePerUpdate;
+		Time mTimePerRender;
+		F32 mInterpolation;
 };
 
 template <typename T, typename ... Args>
@@ -33,10 +33,10 @@ class AnimatorComponent : public SpriteComponent
 
 		void setTexture(ResourceId texture) {}
 		void setTexture(sf::Texture& texture) {}
-		const sf::Texture* getTexture() const { return mSprite.getTexture(); }
+		const sf::Texture* getTexture() const { return SpriteComponent::getTexture(); }
 
 		void setTextureRect(const sf::IntRect& textureRect) {}
-		const sf::IntRect& getTextureRect() const { return mSprite.getTextureRect(); }
+		const sf::IntRect& getTextureRect() const { return SpriteComponent::getTextureRect(); }
 
 	private:
 		bool mPlaying;
@@ -1,11 +1,20 @@
 #include "LayerComponent.hpp"
 
+#include <algorithm>
+
 namespace oe
 {
 
+const I32 LayerComponent::ChunkSize;
+const U32 LayerComponent::ChunkLifetime;
+
 LayerComponent::LayerComponent(Entity& entity)
 	: RenderableComponent(entity)
-	, mVertices(sf::Quads)
+	, mChunks()
+	, mChunkCount()
+	, mBuiltChunks(0)
+	, mVisibleChunks(0)
+	, mRenders(0)
 	, mGeometryUpdated(false)
 	, mTileGrid()
 	, mName("")
@@ -52,11 +61,7 @@ TileId LayerComponent::getTileId(const Vector2i& coords)
 	if (0 <= coords.x && 0 <= coords.y && coords.x < mSize.x && coords.y < mSize.y)
 	{
 		ensureUpdateGeometry();
-		U32 index(coords.x + coords.y * mSize.x);
-		if (index < mTileGrid.size())
-		{
-			return mTileGrid[index];
-		}
+		return mTileGrid.get(coords, 0);
 	}
 	return 0;
 }
@@ -66,17 +71,18 @@ void LayerComponent::setTileId(const Vector2i& coords, TileId id)
 	if (0 <= coords.x && 0 <= coords.y && coords.x < mSize.x && coords.y < mSize.y)
 	{
 		ensureUpdateGeometry();
-		U32 index(coords.x + coords.y * mSize.x);
-		mTileGrid[index] = id;
-		if (mTileset != nullptr)
+		mTileGrid[coords] = id;
+
+		// Only the chunk of the tile has vertices to change, if it is built
+		if (mTileset != nullptr && mGeometryUpdated)
 		{
-			sf::Vertex* vertex(&mVertices[index * 4]);
-			sf::Vector2f pos(mTileset->toPos(id));
-			Vector2 texSize(mTileset->getTileSize());
-			vertex[0].texCoords = pos;
-			vertex[1].texCoords = sf::Vector2f(pos.x + texSize.x, pos.y);
-			vertex[2].texCoords = sf::Vector2f(pos.x + texSize.x, pos.y + texSize.y);
-			vertex[3].texCoords = sf::Vector2f(pos.x, pos.y + texSize.y);
+			Chunk& chunk = mChunks[getChunkIndex(coords)];
+			if (chunk.vertices.getVertexCount() > 0)
+			{
+				const I32 chunkWidth = std::min(ChunkSize, mSize.x - (coords.x / ChunkSize) * ChunkSize);
+				const U32 tile = (coords.x % ChunkSize) + (coords.y % ChunkSize) * chunkWidth;
+				setTexCoords(&chunk.vertices[tile * 4], id);
+			}
 		}
 	}
 }
@@ -203,39 +209,107 @@ void LayerComponent::setHexSideLength(U32 hexSideLength)
 
 void LayerComponent::render(sf::RenderTarget& target)
 {
-	if (mTileset != nullptr)
+	if (mTileset == nullptr)
+	{
+		return;
+	}
+	ensureUpdateGeometry();
+	mRenders++;
+	mVisibleChunks = 0;
+
+	sf::RenderStates states;
+	states.texture = &mTileset->getTexture();
+	states.transform = getGlobalTransform();
+
+	// The view in the space of the layer
+	const sf::View& view = target.getView();
+	const sf::FloatRect viewBounds = states.transform.getInverse().transformRect(sf::FloatRect(view.getCenter() - view.getSize() * 0.5f, view.getSize()));
+
+	for (U32 i = 0; i < mChunks.size(); i++)
 	{
-		sf::RenderStates states;
-		states.texture = &mTileset->getTexture();
-		states.transform = getGlobalTransform();
-		target.draw(mVertices, states);
+		Chunk& chunk = mChunks[i];
+		if (chunk.bounds.intersects(viewBounds))
+		{
+			if (chunk.vertices.getVertexCount() == 0)
+			{
+				buildChunk(i);
+			}
+			target.draw(chunk.vertices, states);
+			chunk.lastRender = mRenders;
+			mVisibleChunks++;
+		}
+		else if (chunk.vertices.getVertexCount() > 0 && mRenders - chunk.lastRender > ChunkLifetime)
+		{
+			releaseChunk(i);
+		}
 	}
 }
 
 void LayerComponent::updateGeometry()
 {
+	if (mTileGrid.getSize() != mSize)
+	{
+		mTileGrid.create(mSize, 0); // TODO : Keep tile id already set in order
+	}
 	if (mTileset == nullptr || mSize.x == 0 || mSize.y == 0 || mTileSize.x == 0 || mTileSize.y == 0)
 	{
 		return;
 	}
-	sf::Vector2f texSize(toSF(Vector2(mTileset->getTileSize())));
-	mVertices.resize(mSize.x * mSize.y * 4);
-	mTileGrid.resize(mSize.x * mSize.y * 4); // TODO : Keep tile id already set in order
-	Vector2i coords;
-	for (coords.x = 0; coords.x < mSize.x; coords.x++)
+
+	// The vertices are built when the chunks are seen
+	mChunkCount.x = (mSize.x + ChunkSize - 1) / ChunkSize;
+	mChunkCount.y = (mSize.y + ChunkSize - 1) / ChunkSize;
+	mChunks.clear();
+	mChunks.resize(mChunkCount.x * mChunkCount.y);
+	mBuiltChunks = 0;
+
+	// Bounds from the tiles on the borders of the chunk : the first two and last two rows cover the staggered ones
+	const F32 delta = mTileset->getTileSize().y - (F32)mTileSize.y;
+	sf::FloatRect layerBounds;
+	for (I32 cy = 0; cy < mChunkCount.y; cy++)
 	{
-		for (coords.y = 0; coords.y < mSize.y; coords.y++)
+		for (I32 cx = 0; cx < mChunkCount.x; cx++)
 		{
-			// Get the position of the vertex
-			Vector2 pos = MapUtility::coordsToWorld(coords, mOrientation, mTileSize, mStaggerIndex, mStaggerAxis, mHexSideLength);
-			sf::Vertex* vertex = &mVertices[(coords.x + coords.y * mSize.x) * 4];
-			F32 delta = texSize.y - (F32)mTileSize.y;
-			vertex[0].position = sf::Vector2f(pos.x, pos.y - delta);
-			vertex[1].position = sf::Vector2f(pos.x + mTileSize.x, pos.y - delta);
-			vertex[2].position = sf::Vector2f(pos.x + mTileSize.x, pos.y + mTileSize.y);
-			vertex[3].position = sf::Vector2f(pos.x, pos.y + mTileSize.y);
+			const I32 left = cx * ChunkSize;
+			const I32 top = cy * ChunkSize;
+			const I32 right = std::min(left + ChunkSize, mSize.x) - 1;
+			const I32 bottom = std::min(top + ChunkSize, mSize.y) - 1;
+			const I32 rows[4] = { top, std::min(top + 1, bottom), std::max(bottom - 1, top), bottom };
+			const I32 columns[2] = { left, right };
+			Vector2 min(1e30f, 1e30f);
+			Vector2 max(-1e30f, -1e30f);
+			for (I32 row : rows)
+			{
+				for (I32 column : columns)
+				{
+					const Vector2 pos = MapUtility::coordsToWorld(Vector2i(column, row), mOrientation, mTileSize, mStaggerIndex, mStaggerAxis, mHexSideLength);
+					min.x = std::min(min.x, pos.x);
+					min.y = std::min(min.y, pos.y - delta);
+					max.x = std::max(max.x, pos.x + mTileSize.x);
+					max.y = std::max(max.y, pos.y + mTileSize.y);
+				}
+			}
+			Chunk& chunk = mChunks[cx + cy * mChunkCount.x];
+			chunk.vertices.setPrimitiveType(sf::Quads);
+			chunk.bounds = sf::FloatRect(min.x, min.y, max.x - min.x, max.y - min.y);
+			chunk.lastRender = 0;
+			if (cx == 0 && cy == 0)
+			{
+				layerBounds = chunk.bounds;
+			}
+			else
+			{
+				const F32 layerRight = std::max(layerBounds.left + layerBounds.width, max.x);
+				const F32 layerBottom = std::max(layerBounds.top + layerBounds.height, max.y);
+				layerBounds.left = std::min(layerBounds.left, min.x);
+				layerBounds.top = std::min(layerBounds.top, min.y);
+				layerBounds.width = layerRight - layerBounds.left;
+				layerBounds.height = layerBottom - layerBounds.top;
+			}
 		}
 	}
+	mLocalAABB = layerBounds;
+	invalidateLocalAABB();
 	mGeometryUpdated = true;
 }
 
@@ -252,4 +326,82 @@ void LayerComponent::ensureUpdateGeometry()
 	}
 }
 
+U32 LayerComponent::getChunkCount() const
+{
+	return mChunks.size();
+}
+
+U32 LayerComponent::getBuiltChunkCount() const
+{
+	return mBuiltChunks;
+}
+
+U32 LayerComponent::getVisibleChunkCount() const
+{
+	return mVisibleChunks;
+}
+
+U32 LayerComponent::getChunkIndex(const Vector2i& coords) const
+{
+	return (coords.x / ChunkSize) + (coords.y / ChunkSize) * mChunkCount.x;
+}
+
+void LayerComponent::buildChunk(U32 index)
+{
+	ASSERT(index < mChunks.size());
+	ASSERT(mTileset != nullptr);
+	const I32 left = (index % mChunkCount.x) * ChunkSize;
+	const I32 top = (index / mChunkCount.x) * ChunkSize;
+	const I32 width = std::min(ChunkSize, mSize.x - left);
+	const I32 height = std::min(ChunkSize, mSize.y - top);
+	const F32 delta = mTileset->getTileSize().y - (F32)mTileSize.y;
+
+	// Row by row, as setTileId expects
+	sf::VertexArray& vertices = mChunks[index].vertices;
+	vertices.resize(width * height * 4);
+	Vector2i coords;
+	for (coords.y = top; coords.y < top + height; coords.y++)
+	{
+		for (coords.x = left; coords.x < left + width; coords.x++)
+		{
+			const Vector2 pos = MapUtility::coordsToWorld(coords, mOrientation, mTileSize, mStaggerIndex, mStaggerAxis, mHexSideLength);
+			sf::Vertex* vertex = &vertices[((coords.x - left) + (coords.y - top) * width) * 4];
+			vertex[0].position = sf::Vector2f(pos.x, pos.y - delta);
+			vertex[1].position = sf::Vector2f(pos.x + mTileSize.x, pos.y - delta);
+			vertex[2].position = sf::Vector2f(pos.x + mTileSize.x, pos.y + mTileSize.y);
+			vertex[3].position = sf::Vector2f(pos.x, pos.y + mTileSize.y);
+			setTexCoords(vertex, mTileGrid[coords]);
+		}
+	}
+	mBuiltChunks++;
+}
+
+void LayerComponent::releaseChunk(U32 index)
+{
+	ASSERT(index < mChunks.size());
+
+	// A new array to give the memory back, clear() keeps it
+	mChunks[index].vertices = sf::VertexArray(sf::Quads);
+	mBuiltChunks--;
+}
+
+void LayerComponent::setTexCoords(sf::Vertex* vertex, TileId id) const
+{
+	// Empty tile (0 or not in the tileset) : null texture coordinates
+	if (!mTileset->hasId(id))
+	{
+		for (U32 i = 0; i < 4; i++)
+		{
+			vertex[i].texCoords = sf::Vector2f();
+		}
+		return;
+	}
+	const sf::Vector2f pos(mTileset->toPos(id));
+	const Vector2 texSize(mTileset->getTileSize());
+	vertex[0].texCoords = pos;
+	vertex[1].texCoords = sf::Vector2f(pos.x + texSize.x, pos.y);
+	vertex[2].texCoords = sf::Vector2f(pos.x + texSize.x, pos.y + texSize.y);
+	vertex[3].texCoords = sf::Vector2f(pos.x, pos.y + texSize.y);
+}
+
 } // namespace oe
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "../RenderableComponent.hpp"
 
+#include "../../System/HexGrid.hpp"
 #include "../../System/Tileset.hpp"
 #include "../../System/MapUtility.hpp"
 
@@ -11,6 +12,8 @@
 namespace oe
 {
 
+// The tiles are drawn by chunks of ChunkSize x ChunkSize, each with its own vertices
+// A chunk builds its vertices when it is seen for the first time, and releases them when not seen for a while
 class LayerComponent : public RenderableComponent
 {
 	public:
@@ -55,12 +58,36 @@ class LayerComponent : public RenderableComponent
 		bool isGeometryUpdated() const;
 		void ensureUpdateGeometry();
 
+		U32 getChunkCount() const;
+		U32 getBuiltChunkCount() const; // Chunks with vertices
+		U32 getVisibleChunkCount() const; // Last render
+
+		static const I32 ChunkSize = 32;
+		static const U32 ChunkLifetime = 300; // Renders without being seen before releasing the vertices
+
+	private:
+		struct Chunk
+		{
+			sf::VertexArray vertices; // Empty until the chunk is seen
+			sf::FloatRect bounds; // Local space
+			U32 lastRender;
+		};
+
+		U32 getChunkIndex(const Vector2i& coords) const;
+		void buildChunk(U32 index);
+		void releaseChunk(U32 index);
+		void setTexCoords(sf::Vertex* vertex, TileId id) const;
+
 	private:
-		sf::VertexArray mVertices;
+		std::vector<Chunk> mChunks;
+		Vector2i mChunkCount;
+		U32 mBuiltChunks;
+		U32 mVisibleChunks;
+		U32 mRenders;
 
 		bool mGeometryUpdated;
 
-		std::vector<TileId> mTileGrid;
+		HexGrid<TileId> mTileGrid;
 
 		std::string mName;
 		Tileset* mTileset;
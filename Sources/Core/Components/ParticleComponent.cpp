@@ -30,6 +30,10 @@ ParticleComponent::ParticleComponent(Entity& entity)
 
 void ParticleComponent::setTexture(ResourceId id)
 {
+	if (getWorld().getApplication().isHeadless())
+	{
+		return;
+	}
 	mTexture = &getWorld().getTextures().get(id);
 }
 
@@ -211,6 +215,11 @@ void ParticleComponent::render(sf::RenderTarget& target)
 	}
 }
 
+bool ParticleComponent::isBounded() const
+{
+	return false;
+}
+
 U32 ParticleComponent::computeParticleCount(Time dt)
 {
 	// We want to fulfill the desired particle rate as exact as possible. Since the amount of emitted particles per frame is
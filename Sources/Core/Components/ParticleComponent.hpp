@@ -75,6 +75,8 @@ class ParticleComponent : public RenderableComponent
 
 		virtual void render(sf::RenderTarget& target);
 
+		virtual bool isBounded() const; // The particles move freely
+
 	private:
 		U32 computeParticleCount(Time dt);
 		void updateParticle(Particle& particle, Time dt);
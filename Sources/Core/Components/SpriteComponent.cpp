@@ -6,51 +6,93 @@ namespace oe
 
 SpriteComponent::SpriteComponent(Entity& entity)
 	: RenderableComponent(entity)
-	, mSprite()
+	, mStorage(getRenderSystem().getSprites())
+	, mSpriteId(SpriteStorage::InvalidId)
 {
+	mSpriteId = mStorage.create(this);
+}
+
+SpriteComponent::~SpriteComponent()
+{
+	mStorage.destroy(mSpriteId);
 }
 
 void SpriteComponent::setTexture(ResourceId texture)
 {
-	mSprite.setTexture(getWorld().getTextures().get(texture));
-	mLocalAABB = mSprite.getLocalBounds();
+	// Textures are not loaded in headless mode : the sprite keeps its rect and draws nothing
+	if (getWorld().getApplication().isHeadless())
+	{
+		return;
+	}
+	mStorage.setTexture(mSpriteId, &getWorld().getTextures().get(texture));
+	updateLocalAABB();
 }
 
 void SpriteComponent::setTexture(sf::Texture& texture)
 {
-	mSprite.setTexture(texture);
-	mLocalAABB = mSprite.getLocalBounds();
+	mStorage.setTexture(mSpriteId, &texture);
+	updateLocalAABB();
 }
 
 const sf::Texture* SpriteComponent::getTexture() const
 {
-	return mSprite.getTexture();
+	return mStorage.getTexture(mSpriteId);
 }
 
 void SpriteComponent::setTextureRect(const sf::IntRect& textureRect)
 {
-	mSprite.setTextureRect(textureRect);
-	mLocalAABB = mSprite.getLocalBounds();
+	mStorage.setTextureRect(mSpriteId, textureRect);
+	updateLocalAABB();
 }
 
 const sf::IntRect& SpriteComponent::getTextureRect() const
 {
-	return mSprite.getTextureRect();
+	return mStorage.getTextureRect(mSpriteId);
 }
 
 void SpriteComponent::setColor(const Color& color)
 {
-	mSprite.setColor(toSF(color));
+	mStorage.setColor(mSpriteId, toSF(color));
 }
 
 Color SpriteComponent::getColor() const
 {
-	return toOE(mSprite.getColor());
+	return toOE(mStorage.getColor(mSpriteId));
+}
+
+void SpriteComponent::setVisible(bool visible)
+{
+	RenderableComponent::setVisible(visible);
+	mStorage.setVisible(mSpriteId, visible);
 }
 
 void SpriteComponent::render(sf::RenderTarget& target)
 {
-	target.draw(mSprite, getGlobalTransform());
+	mStorage.render(target, mSpriteId);
+}
+
+void SpriteComponent::onNodeInvalidated(const Node* node)
+{
+	RenderableComponent::onNodeInvalidated(node);
+	mStorage.invalidate(mSpriteId);
+}
+
+void SpriteComponent::onNodeInvalidatedZ(const Node* node)
+{
+	RenderableComponent::onNodeInvalidatedZ(node);
+	mStorage.invalidateZ(mSpriteId);
+}
+
+SpriteStorage::Id SpriteComponent::getSpriteId() const
+{
+	return mSpriteId;
+}
+
+void SpriteComponent::updateLocalAABB()
+{
+	const sf::IntRect& rect = mStorage.getTextureRect(mSpriteId);
+	mLocalAABB = sf::FloatRect(0.0f, 0.0f, static_cast<F32>(std::abs(rect.width)), static_cast<F32>(std::abs(rect.height)));
+	invalidateLocalAABB();
 }
 
 } // namespace oe
\ No newline at end of file
@@ -2,17 +2,19 @@
 #define OE_SPRITECOMPONENT_HPP
 
 #include "../RenderableComponent.hpp"
+#include "../Systems/SpriteStorage.hpp"
 
-#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
 namespace oe
 {
 
+// The data of the sprite is kept in the SpriteStorage of the RenderSystem
 class SpriteComponent : public RenderableComponent
 {
 	public:
 		SpriteComponent(Entity& entity);
+		~SpriteComponent();
 
 		void setTexture(ResourceId texture);
 		void setTexture(sf::Texture& texture);
@@ -24,10 +26,21 @@ class SpriteComponent : public RenderableComponent
 		void setColor(const Color& color);
 		Color getColor() const;
 
+		virtual void setVisible(bool visible);
+
 		virtual void render(sf::RenderTarget& target);
 
+		virtual void onNodeInvalidated(const Node* node);
+		virtual void onNodeInvalidatedZ(const Node* node);
+
+		virtual SpriteStorage::Id getSpriteId() const;
+
+	private:
+		void updateLocalAABB();
+
 	protected:
-		sf::Sprite mSprite;
+		SpriteStorage& mStorage;
+		SpriteStorage::Id mSpriteId;
 };
 
 } // namespace oe
@@ -15,12 +15,14 @@ void TextComponent::setFont(ResourceId font)
 {
 	mText.setFont(getWorld().getFonts().get(font));
 	mLocalAABB = mText.getLocalBounds();
+	invalidateLocalAABB();
 }
 
 void TextComponent::setFont(sf::Font& font)
 {
 	mText.setFont(font);
 	mLocalAABB = mText.getLocalBounds();
+	invalidateLocalAABB();
 }
 
 const sf::Font* TextComponent::getFont() const
@@ -33,6 +35,7 @@ void TextComponent::setString(const std::string& string)
 	mString = string;
 	mText.setString(string);
 	mLocalAABB = mText.getLocalBounds();
+	invalidateLocalAABB();
 }
 
 const std::string& TextComponent::getString() const
@@ -74,6 +77,7 @@ void TextComponent::setOutlineThickness(F32 thickness)
 {
 	mText.setOutlineThickness(thickness);
 	mLocalAABB = mText.getLocalBounds();
+	invalidateLocalAABB();
 }
 
 F32 TextComponent::getOutlineThickness() const
@@ -85,6 +89,7 @@ void TextComponent::setCharacterSize(U32 size)
 {
 	mText.setCharacterSize(size);
 	mLocalAABB = mText.getLocalBounds();
+	invalidateLocalAABB();
 }
 
 U32 TextComponent::getCharacterSize() const
@@ -7,6 +7,9 @@ namespace oe
 Entity::Entity(World& world) //-V730
 	: mWorld(world)
 	, mId(Id::generate<Entity>())
+	, mType(&EntityType::get<Entity>())
+	, mHandleIndex(0)
+	, mHandleGeneration(0)
 	, mPlaying(false)
 	, mComponents()
 	, mSceneComponents()
@@ -27,6 +30,16 @@ UID Entity::getId() const
 	return mId;
 }
 
+const EntityType& Entity::getType() const
+{
+	return *mType;
+}
+
+EntityHandle Entity::getHandle() const
+{
+	return EntityHandle(&mWorld, mHandleIndex, mHandleGeneration);
+}
+
 void Entity::onCreate()
 {
 }
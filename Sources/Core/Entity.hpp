@@ -4,6 +4,7 @@
 #include "Component.hpp"
 #include "SceneComponent.hpp"
 #include "ComponentList.hpp"
+#include "EntityType.hpp"
 
 #include "../System/Id.hpp"
 #include "../System/Node.hpp"
@@ -15,15 +16,26 @@ namespace oe
 {
 
 class World;
+class EntityHandle;
 class Entity : public Node
 {
 	public:
+		using EntityClass = Entity;
+
 		Entity(World& world);
 		virtual ~Entity();
 
 		World& getWorld();
 		UID getId() const;
 
+		// Type given by World::createEntity<T>, checked by EntityHandle::getAs<T>
+		const EntityType& getType() const;
+		template <typename T>
+		bool isA() const;
+
+		// Handle given by the world when the entity was created
+		EntityHandle getHandle() const;
+
 		const ComponentList& getComponents() const;
 		const SceneComponentList& getSceneComponents() const;
 
@@ -39,6 +51,7 @@ class Entity : public Node
 		void spawnComponents();
 		virtual void onDestroy();
 		void destroyComponents();
+		// Called on the main thread, in the order of the playing list
 		virtual void update(Time dt);
 		void setPlaying(bool playing);
 
@@ -50,11 +63,20 @@ class Entity : public Node
 	private:
 		World& mWorld;
 		UID mId;
+		const EntityType* mType;
+		U32 mHandleIndex;
+		U32 mHandleGeneration;
 		bool mPlaying;
 		ComponentList mComponents;
 		SceneComponentList mSceneComponents;
 };
 
+template <typename T>
+bool Entity::isA() const
+{
+	return mType->isA(EntityType::get<T>());
+}
+
 } // namespace oe
 
 #endif // OE_ENTITY_HPP
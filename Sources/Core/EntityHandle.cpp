@@ -5,71 +5,64 @@ namespace oe
 {
 
 EntityHandle::EntityHandle()
-	: mEntityId(0)
+	: mWorld(nullptr)
 	, mHandleIndex(0)
-	, mWorld(nullptr)
+	, mGeneration(0)
 {
 }
 
-EntityHandle::EntityHandle(World* world, const Entity& entity, U32 handleIndex)
-	: mEntityId(entity.getId())
+EntityHandle::EntityHandle(World* world, U32 handleIndex, U32 generation)
+	: mWorld(world)
 	, mHandleIndex(handleIndex)
-	, mWorld(world)
+	, mGeneration(generation)
 {
 }
 
 EntityHandle::EntityHandle(const EntityHandle& handle)
-	: mEntityId(handle.mEntityId)
-    , mHandleIndex(handle.mHandleIndex)
-	, mWorld(handle.mWorld)
+	: mWorld(handle.mWorld)
+	, mHandleIndex(handle.mHandleIndex)
+	, mGeneration(handle.mGeneration)
 {
 }
 
 void EntityHandle::operator=(const EntityHandle& handle)
 {
-	mEntityId = handle.mEntityId;
-	mHandleIndex = handle.mHandleIndex;
 	mWorld = handle.mWorld;
+	mHandleIndex = handle.mHandleIndex;
+	mGeneration = handle.mGeneration;
 }
 
 Entity* EntityHandle::get() const
 {
-	Entity* entity = (mWorld != nullptr) ? mWorld->getEntityFromHandleIndex(mHandleIndex) : nullptr;
-	if (entity != nullptr && entity->getId() == mEntityId)
-	{
-		return entity;
-	}
-	return nullptr;
+	return (mWorld != nullptr) ? mWorld->getEntity(mHandleIndex, mGeneration) : nullptr;
 }
 
 bool EntityHandle::isValid() const
 {
-	if (mEntityId == 0)
-	{
-		return false;
-	}
-	Entity* entity = (mWorld != nullptr) ? mWorld->getEntityFromHandleIndex(mHandleIndex) : nullptr;
-	return entity != nullptr && entity->getId() == mEntityId;
+	return mWorld != nullptr && mWorld->isAlive(mHandleIndex, mGeneration);
 }
 
 bool EntityHandle::operator==(const EntityHandle& handle) const
 {
-	return mEntityId == handle.mEntityId;
+	return mHandleIndex == handle.mHandleIndex && mGeneration == handle.mGeneration && mWorld == handle.mWorld;
 }
 
 bool EntityHandle::operator!=(const EntityHandle& handle) const
 {
-	return mEntityId != handle.mEntityId;
+	return !operator==(handle);
 }
 
 void EntityHandle::invalidate()
 {
-	mEntityId = 0;
+	mWorld = nullptr;
+	mHandleIndex = 0;
+	mGeneration = 0;
 }
 
 UID EntityHandle::getEntityId() const
 {
-	return mEntityId;
+	Entity* entity = get();
+	return (entity != nullptr) ? entity->getId() : 0;
 }
 
 U32 EntityHandle::getHandleIndex() const
@@ -77,4 +70,9 @@ U32 EntityHandle::getHandleIndex() const
 	return mHandleIndex;
 }
 
+U32 EntityHandle::getGeneration() const
+{
+	return mGeneration;
+}
+
 } // namespace oe
\ No newline at end of file
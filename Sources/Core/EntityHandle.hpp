@@ -3,8 +3,6 @@
 
 #include "Entity.hpp"
 
-#include "../ExtLibs/FastDynamicCast/fast_dynamic_cast.h"
-
 namespace oe
 {
 
@@ -13,8 +11,17 @@ class World;
 class EntityHandle
 {
 	public:
+		// Live handles of a world never share their index
+		struct Hash
+		{
+			std::size_t operator()(const EntityHandle& handle) const
+			{
+				return (static_cast<std::size_t>(handle.mGeneration) << 20) ^ handle.mHandleIndex;
+			}
+		};
+
 		EntityHandle();
-		EntityHandle(World* world, const Entity& entity, U32 handleIndex);
+		EntityHandle(World* world, U32 handleIndex, U32 generation);
 
 		EntityHandle(const EntityHandle& handle);
 		void operator=(const EntityHandle& handle);
@@ -36,20 +43,77 @@ class EntityHandle
 
 		void invalidate();
 
-		// You should avoid using those two functions : Only used for debugging and internal management
-		UID getEntityId() const;
+		// You should avoid using those functions : Only used for debugging and internal management
+		UID getEntityId() const; // 0 if the handle is not valid
 		U32 getHandleIndex() const;
+		U32 getGeneration() const;
 
 	private:
-		UID mEntityId;
-		U32 mHandleIndex;
 		World* mWorld;
+		U32 mHandleIndex;
+		U32 mGeneration;
+};
+
+// Handle whose type was checked when it was set : get() only checks that the entity is alive
+template <typename T>
+class TypedHandle
+{
+	public:
+		TypedHandle()
+			: mHandle()
+		{
+		}
+
+		// Invalid if the entity is not a T
+		TypedHandle(const EntityHandle& handle)
+			: mHandle()
+		{
+			if (handle.getAs<T>() != nullptr)
+			{
+				mHandle = handle;
+			}
+		}
+
+		T* operator->() const
+		{
+			return get();
+		}
+
+		T* get() const
+		{
+			return static_cast<T*>(mHandle.get());
+		}
+
+		const EntityHandle& getHandle() const
+		{
+			return mHandle;
+		}
+
+		operator const EntityHandle&() const
+		{
+			return mHandle;
+		}
+
+		bool isValid() const
+		{
+			return mHandle.isValid();
+		}
+
+		void invalidate()
+		{
+			mHandle.invalidate();
+		}
+
+	private:
+		EntityHandle mHandle;
 };
 
 template <typename T>
 T* EntityHandle::getAs() const
 {
-	return fast_dynamic_cast<T*>(get());
+	// One compare instead of a dynamic_cast
+	Entity* entity = get();
+	return (entity != nullptr && entity->isA<T>()) ? static_cast<T*>(entity) : nullptr;
 }
 
 } // namespace oe
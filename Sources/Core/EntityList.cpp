@@ -3,23 +3,13 @@
 namespace oe
 {
 
-EntityList::EntityList() : List<EntityHandle>()
+EntityList::EntityList() : List<EntityHandle, EntityHandle::Hash>()
 {
 }
 
 void EntityList::update()
 {
-	for (auto itr = begin(); itr != end(); )
-	{
-		if (!(*itr).isValid())
-		{
-			itr = mList.erase(itr);
-		}
-		else
-		{
-			++itr;
-		}
-	}
+	removeIf([](const EntityHandle& handle) { return !handle.isValid(); });
 }
 
 } // namespace oe
\ No newline at end of file
@@ -7,7 +7,7 @@
 namespace oe
 {
 
-class EntityList : public List<EntityHandle>
+class EntityList : public List<EntityHandle, EntityHandle::Hash>
 {
 	public:
 		EntityList();
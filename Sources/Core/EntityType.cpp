@@ -0,0 +1,47 @@
+#include "EntityType.hpp"
+
+#include <atomic>
+
+namespace oe
+{
+
+const U32 EntityType::MaxDepth;
+
+EntityType::EntityType(const EntityType* parent)
+	: mId(0)
+	, mDepth(0)
+	, mAncestors()
+{
+	// Types can be used for the first time by different threads
+	static std::atomic<U32> sNextId(0);
+	mId = sNextId++;
+	if (parent != nullptr)
+	{
+		ASSERT(parent->mDepth + 1 < MaxDepth);
+		mDepth = parent->mDepth + 1;
+		for (U32 i = 0; i < mDepth; i++)
+		{
+			mAncestors[i] = parent->mAncestors[i];
+		}
+	}
+	mAncestors[mDepth] = mId;
+}
+
+U32 EntityType::getId() const
+{
+	return mId;
+}
+
+U32 EntityType::getDepth() const
+{
+	return mDepth;
+}
+
+template <>
+const EntityType& EntityType::get<Entity>()
+{
+	static const EntityType type(nullptr);
+	return type;
+}
+
+} // namespace oe
@@ -0,0 +1,60 @@
+#ifndef OE_ENTITYTYPE_HPP
+#define OE_ENTITYTYPE_HPP
+
+#include "../System/Prerequisites.hpp"
+#include "../System/NonCopyable.hpp"
+
+#include <type_traits>
+
+// In the class body of every Entity subclass, used by World::createEntity and EntityHandle::getAs
+#define OeEntity(Class, Parent) \
+	public: \
+		using EntityClass = Class; \
+		using EntityParent = Parent; \
+	private:
+
+namespace oe
+{
+
+class Entity;
+
+// Type of an entity, given once by World::createEntity
+// Each type stores the ids of its parents by depth : "is a T" is one compare at the depth of T
+class EntityType : private NonCopyable
+{
+	public:
+		static const U32 MaxDepth = 8;
+
+		explicit EntityType(const EntityType* parent);
+
+		U32 getId() const;
+		U32 getDepth() const;
+
+		bool isA(const EntityType& type) const
+		{
+			return type.mDepth <= mDepth && mAncestors[type.mDepth] == type.mId;
+		}
+
+		template <typename T>
+		static const EntityType& get();
+
+	private:
+		U32 mId;
+		U32 mDepth;
+		U32 mAncestors[MaxDepth]; // mAncestors[mDepth] == mId
+};
+
+template <typename T>
+const EntityType& EntityType::get()
+{
+	static_assert(std::is_same<typename T::EntityClass, T>::value, "Entity class without OeEntity(Class, Parent)");
+	static const EntityType type(&get<typename T::EntityParent>());
+	return type;
+}
+
+template <>
+const EntityType& EntityType::get<Entity>();
+
+} // namespace oe
+
+#endif // OE_ENTITYTYPE_HPP
@@ -15,6 +15,8 @@ namespace oe
 class World;
 class Map : public Entity
 {
+	OeEntity(Map, Entity)
+
 	public:
 		Map(World& world);
 		virtual ~Map();
@@ -11,6 +11,11 @@ RenderableComponent::RenderableComponent(Entity& entity) //-V730
 	, mGlobalAABB()
 	, mGlobalAABBUpdated(false)
 	, mVisible(true)
+	, mOrderIndex(RenderOrder::InvalidIndex)
+	, mOrderDirty(false)
+	, mCullingCell(CullingGrid::NoCell)
+	, mCullingSlot(0)
+	, mCullingStamp(0)
 {
 }
 
@@ -33,6 +38,11 @@ const sf::FloatRect& RenderableComponent::getGlobalAABB() const
 	return mGlobalAABB;
 }
 
+bool RenderableComponent::isBounded() const
+{
+	return true;
+}
+
 bool RenderableComponent::isVisible() const
 {
 	return mVisible;
@@ -48,6 +58,11 @@ RenderSystem& RenderableComponent::getRenderSystem()
 	return getWorld().getRenderSystem();
 }
 
+SpriteStorage::Id RenderableComponent::getSpriteId() const
+{
+	return SpriteStorage::InvalidId;
+}
+
 void RenderableComponent::onCreate()
 {
 	mInvalidationSlot.connect(onNodeInvalidation, this, &RenderableComponent::onNodeInvalidated);
@@ -66,13 +81,19 @@ void RenderableComponent::onDestroy()
 
 void RenderableComponent::onNodeInvalidated(const Node* node)
 {
-	getRenderSystem().needUpdateOrderY();
+	getRenderSystem().invalidateOrder(this);
 	mGlobalAABBUpdated = false;
 }
 
 void RenderableComponent::onNodeInvalidatedZ(const Node* node)
 {
-	getRenderSystem().needUpdateOrderZ();
+	getRenderSystem().invalidateOrder(this);
+}
+
+void RenderableComponent::invalidateLocalAABB()
+{
+	mGlobalAABBUpdated = false;
+	getRenderSystem().invalidateOrder(this);
 }
 
 } // namespace oe
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define OE_RENDERABLECOMPONENT_HPP
 
 #include "SceneComponent.hpp"
+#include "Systems/SpriteStorage.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -19,26 +20,48 @@ class RenderableComponent : public SceneComponent
 		const sf::FloatRect& getLocalAABB() const;
 		const sf::FloatRect& getGlobalAABB() const;
 
+		// Unbounded renderables can draw anywhere and are never culled, the others draw nothing with empty bounds
+		virtual bool isBounded() const;
+
 		bool isVisible() const;
-		void setVisible(bool visible);
+		virtual void setVisible(bool visible);
 
 		RenderSystem& getRenderSystem();
 
+		// Sprites are drawn in batches by the RenderSystem, the others return InvalidId and are drawn by render()
+		virtual SpriteStorage::Id getSpriteId() const;
+
 		virtual void onCreate();
 		virtual void onSpawn();
 		virtual void onDestroy();
 
-		void onNodeInvalidated(const Node* node);
-		void onNodeInvalidatedZ(const Node* node);
+		virtual void onNodeInvalidated(const Node* node);
+		virtual void onNodeInvalidatedZ(const Node* node);
 
 		OeSlot(oe::Node, onNodeInvalidation, mInvalidationSlot);
 		OeSlot(oe::Node, onNodeInvalidationZ, mInvalidationZSlot);
 
+	protected:
+		// The local AABB changed : the RenderSystem places the renderable again
+		void invalidateLocalAABB();
+
 	protected:
 		sf::FloatRect mLocalAABB;
 		mutable sf::FloatRect mGlobalAABB;
 		mutable bool mGlobalAABBUpdated;
 		bool mVisible;
+
+	private:
+		// Place in the RenderOrder of the RenderSystem
+		friend class RenderOrder;
+		U32 mOrderIndex;
+		bool mOrderDirty;
+
+		// Place in the CullingGrid of the RenderSystem
+		friend class CullingGrid;
+		U64 mCullingCell;
+		U32 mCullingSlot;
+		U32 mCullingStamp;
 };
 
 } // namespace oe
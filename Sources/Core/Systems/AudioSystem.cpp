@@ -7,6 +7,7 @@ AudioSystem::AudioSystem()
 	: mStatus(sf::SoundSource::Playing)
 	, mMusicVolume(100.0f)
 	, mSoundVolume(100.0f)
+	, mEnabled(true)
 {
 }
 
@@ -22,7 +23,7 @@ ResourceId AudioSystem::createMusic(const std::string& id, const std::string& fi
 
 AudioSystem::MusicPtr AudioSystem::playMusic(ResourceId id, bool loop)
 {
-    if (mStatus != sf::SoundSource::Stopped && mMusicFilenames.find(id) != mMusicFilenames.end() && mMusics.size() < MAX_MUSIC)
+    if (mEnabled && mStatus != sf::SoundSource::Stopped && mMusicFilenames.find(id) != mMusicFilenames.end() && mMusics.size() < MAX_MUSIC)
     {
 		MusicPtr m(std::make_shared<sf::Music>());
 		mMusics.push_back(m);
@@ -46,12 +47,16 @@ AudioSystem::MusicPtr AudioSystem::playMusic(const std::string& id, bool loop)
 
 ResourceId AudioSystem::createSound(const std::string& id, const std::string& filename)
 {
+	if (!mEnabled)
+	{
+		return StringHash::hash(id);
+	}
 	return mSoundBuffers.create(id, filename);
 }
 
 AudioSystem::SoundPtr AudioSystem::playSound(ResourceId id)
 {
-    if (mStatus != sf::SoundSource::Stopped && mSoundBuffers.has(id) && mSounds.size() < MAX_SOUND)
+    if (mEnabled && mStatus != sf::SoundSource::Stopped && mSoundBuffers.has(id) && mSounds.size() < MAX_SOUND)
     {
 		SoundPtr s(std::make_shared<sf::Sound>());
         mSounds.push_back(s);
@@ -141,6 +146,21 @@ void AudioSystem::update()
     }
 }
 
+void AudioSystem::setEnabled(bool enabled)
+{
+	if (!enabled)
+	{
+		mMusics.clear();
+		mSounds.clear();
+	}
+	mEnabled = enabled;
+}
+
+bool AudioSystem::isEnabled() const
+{
+	return mEnabled;
+}
+
 void AudioSystem::setGlobalVolume(F32 volume)
 {
     sf::Listener::setGlobalVolume(volume);
@@ -36,6 +36,10 @@ class AudioSystem
 
         void update();
 
+        // A disabled system loads and plays nothing, used without audio device (headless)
+        void setEnabled(bool enabled);
+        bool isEnabled() const;
+
         void setGlobalVolume(F32 volume);
         void setMusicVolume(F32 volume);
         void setSoundVolume(F32 volume);
@@ -56,6 +60,8 @@ class AudioSystem
         F32 mMusicVolume;
         F32 mSoundVolume;
 
+        bool mEnabled;
+
 		static const U32 MAX_MUSIC = 16;
 		static const U32 MAX_SOUND = 240;
 };
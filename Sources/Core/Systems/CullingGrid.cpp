@@ -0,0 +1,242 @@
+#include "CullingGrid.hpp"
+#include "../RenderableComponent.hpp"
+
+#include <cmath>
+
+namespace oe
+{
+
+const U64 CullingGrid::NoCell;
+const U64 CullingGrid::LargeCell;
+const U64 CullingGrid::EmptyCell;
+const I32 CullingGrid::CellBias;
+
+CullingGrid::CullingGrid(F32 cellSize)
+	: mCellSize(cellSize)
+	, mCells()
+	, mLarge()
+	, mCount(0)
+	, mRange()
+	, mChanged(true)
+	, mStamp(0)
+	, mVisibleCount(0)
+	, mVersion(0)
+{
+	ASSERT(cellSize > 0.0f);
+}
+
+void CullingGrid::insert(RenderableComponent* renderable)
+{
+	ASSERT(renderable != nullptr);
+	ASSERT(renderable->mCullingCell == NoCell);
+
+	// Placed by the next update, when its bounds are known
+	mCount++;
+}
+
+void CullingGrid::remove(RenderableComponent* renderable)
+{
+	ASSERT(renderable != nullptr);
+	if (renderable->mCullingCell != NoCell)
+	{
+		unplace(renderable);
+		mChanged = true;
+	}
+	mCount--;
+}
+
+void CullingGrid::update(const std::vector<RenderableComponent*>& renderables)
+{
+	for (RenderableComponent* renderable : renderables)
+	{
+		ASSERT(renderable != nullptr);
+		if (renderable->mCullingCell == NoCell || renderable->mCullingCell != getCell(renderable))
+		{
+			if (renderable->mCullingCell != NoCell)
+			{
+				unplace(renderable);
+			}
+			place(renderable);
+			mChanged = true;
+		}
+	}
+}
+
+void CullingGrid::query(const sf::FloatRect& rect)
+{
+	// A renderable stored in a cell can go half a cell out of it
+	const F32 margin = mCellSize * 0.5f;
+	Range range;
+	range.left = getCellCoord(rect.left - margin);
+	range.top = getCellCoord(rect.top - margin);
+	range.right = getCellCoord(rect.left + rect.width + margin);
+	range.bottom = getCellCoord(rect.top + rect.height + margin);
+
+	bool changed = mChanged || range != mRange;
+	for (U32 i = 0; i < mLarge.size() && !changed; i++)
+	{
+		changed = isInRect(mLarge[i], rect) != isVisible(mLarge[i]);
+	}
+	if (!changed)
+	{
+		return;
+	}
+
+	mStamp++;
+	mVersion++;
+	mRange = range;
+	mChanged = false;
+	mVisibleCount = 0;
+
+	// Zoomed out : fewer cells exist than the view covers
+	const U64 width = static_cast<U64>(range.right - range.left + 1);
+	const U64 height = static_cast<U64>(range.bottom - range.top + 1);
+	if (width * height > mCells.size())
+	{
+		for (auto& cell : mCells)
+		{
+			const I32 x = static_cast<I32>(cell.first >> 32) - CellBias;
+			const I32 y = static_cast<I32>(cell.first & 0xFFFFFFFF) - CellBias;
+			if (x >= range.left && x <= range.right && y >= range.top && y <= range.bottom)
+			{
+				for (RenderableComponent* renderable : cell.second)
+				{
+					renderable->mCullingStamp = mStamp;
+				}
+				mVisibleCount += cell.second.size();
+			}
+		}
+	}
+	else
+	{
+		for (I32 y = range.top; y <= range.bottom; y++)
+		{
+			for (I32 x = range.left; x <= range.right; x++)
+			{
+				auto itr = mCells.find(getCellKey(x, y));
+				if (itr != mCells.end())
+				{
+					for (RenderableComponent* renderable : itr->second)
+					{
+						renderable->mCullingStamp = mStamp;
+					}
+					mVisibleCount += itr->second.size();
+				}
+			}
+		}
+	}
+
+	for (RenderableComponent* renderable : mLarge)
+	{
+		if (isInRect(renderable, rect))
+		{
+			renderable->mCullingStamp = mStamp;
+			mVisibleCount++;
+		}
+	}
+}
+
+bool CullingGrid::isVisible(const RenderableComponent* renderable) const
+{
+	ASSERT(renderable != nullptr);
+	return renderable->mCullingStamp == mStamp;
+}
+
+U32 CullingGrid::getCount() const
+{
+	return mCount;
+}
+
+U32 CullingGrid::getVisibleCount() const
+{
+	return mVisibleCount;
+}
+
+U32 CullingGrid::getVersion() const
+{
+	return mVersion;
+}
+
+bool CullingGrid::Range::operator!=(const Range& other) const
+{
+	return left != other.left || top != other.top || right != other.right || bottom != other.bottom;
+}
+
+void CullingGrid::place(RenderableComponent* renderable)
+{
+	const U64 cell = getCell(renderable);
+	renderable->mCullingCell = cell;
+	if (cell == EmptyCell)
+	{
+		return;
+	}
+	std::vector<RenderableComponent*>& renderables = (cell == LargeCell) ? mLarge : mCells[cell];
+	renderable->mCullingSlot = renderables.size();
+	renderables.push_back(renderable);
+}
+
+void CullingGrid::unplace(RenderableComponent* renderable)
+{
+	const U64 cell = renderable->mCullingCell;
+	renderable->mCullingCell = NoCell;
+	if (cell == EmptyCell)
+	{
+		return;
+	}
+	std::vector<RenderableComponent*>& renderables = (cell == LargeCell) ? mLarge : mCells[cell];
+	ASSERT(renderable->mCullingSlot < renderables.size());
+	ASSERT(renderables[renderable->mCullingSlot] == renderable);
+
+	// The last renderable of the cell takes its place
+	RenderableComponent* last = renderables.back();
+	renderables[renderable->mCullingSlot] = last;
+	last->mCullingSlot = renderable->mCullingSlot;
+	renderables.pop_back();
+
+	// Queries only walk the cells that hold renderables
+	if (renderables.empty() && cell != LargeCell)
+	{
+		mCells.erase(cell);
+	}
+}
+
+U64 CullingGrid::getCell(const RenderableComponent* renderable) const
+{
+	if (!renderable->isBounded())
+	{
+		return LargeCell;
+	}
+	const sf::FloatRect& localBounds = renderable->getLocalAABB();
+	if (localBounds.width <= 0.0f || localBounds.height <= 0.0f)
+	{
+		return EmptyCell;
+	}
+	const sf::FloatRect& bounds = renderable->getGlobalAABB();
+	if (bounds.width > mCellSize || bounds.height > mCellSize)
+	{
+		return LargeCell;
+	}
+	return getCellKey(getCellCoord(bounds.left + bounds.width * 0.5f), getCellCoord(bounds.top + bounds.height * 0.5f));
+}
+
+bool CullingGrid::isInRect(const RenderableComponent* renderable, const sf::FloatRect& rect) const
+{
+	// Unbounded, the renderable can draw anywhere
+	if (!renderable->isBounded())
+	{
+		return true;
+	}
+	return rect.intersects(renderable->getGlobalAABB());
+}
+
+I32 CullingGrid::getCellCoord(F32 value) const
+{
+	return static_cast<I32>(std::floor(value / mCellSize));
+}
+
+U64 CullingGrid::getCellKey(I32 x, I32 y)
+{
+	return (static_cast<U64>(static_cast<U32>(x + CellBias)) << 32) | static_cast<U64>(static_cast<U32>(y + CellBias));
+}
+
+} // namespace oe
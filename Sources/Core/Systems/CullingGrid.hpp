@@ -0,0 +1,80 @@
+#ifndef OE_CULLINGGRID_HPP
+#define OE_CULLINGGRID_HPP
+
+#include "../../System/Prerequisites.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace oe
+{
+
+class RenderableComponent;
+
+// Loose uniform grid of the global bounds of the renderables, used to find the ones in the view
+// A renderable is stored in the cell of its center, so a query looks half a cell further
+// Renderables larger than a cell, or unbounded (particles), are tested one by one
+// Renderables with empty bounds draw nothing : they are kept out of the grid and never visible
+// The visible set only changes when the view covers other cells, or when a renderable changes of cell
+class CullingGrid
+{
+	public:
+		static const U64 NoCell = 0xFFFFFFFFFFFFFFFFULL;
+
+		CullingGrid(F32 cellSize = 256.0f);
+
+		void insert(RenderableComponent* renderable);
+		void remove(RenderableComponent* renderable);
+
+		// Move the renderables whose bounds changed to their new cell
+		void update(const std::vector<RenderableComponent*>& renderables);
+
+		// Mark the renderables around the rect as visible, only when the visible set may have changed
+		void query(const sf::FloatRect& rect);
+		bool isVisible(const RenderableComponent* renderable) const;
+
+		U32 getCount() const;
+		U32 getVisibleCount() const; // Last query
+		U32 getVersion() const; // Changes with the visible set
+
+	private:
+		struct Range
+		{
+			bool operator!=(const Range& other) const;
+
+			I32 left;
+			I32 top;
+			I32 right;
+			I32 bottom;
+		};
+
+		void place(RenderableComponent* renderable);
+		void unplace(RenderableComponent* renderable);
+		U64 getCell(const RenderableComponent* renderable) const;
+		bool isInRect(const RenderableComponent* renderable, const sf::FloatRect& rect) const;
+		I32 getCellCoord(F32 value) const;
+
+		static U64 getCellKey(I32 x, I32 y);
+
+		static const U64 LargeCell = NoCell - 1;
+		static const U64 EmptyCell = NoCell - 2;
+		static const I32 CellBias = 0x40000000; // Keeps the keys of the cells away from NoCell, LargeCell and EmptyCell
+
+	private:
+		F32 mCellSize;
+		std::unordered_map<U64, std::vector<RenderableComponent*>> mCells;
+		std::vector<RenderableComponent*> mLarge;
+		U32 mCount;
+
+		Range mRange; // Cells covered by the last query
+		bool mChanged; // A renderable was added, removed, or changed of cell since the last query
+		U32 mStamp;
+		U32 mVisibleCount;
+		U32 mVersion;
+};
+
+} // namespace oe
+
+#endif // OE_CULLINGGRID_HPP
@@ -0,0 +1,261 @@
+#include "RenderOrder.hpp"
+#include "../RenderableComponent.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace oe
+{
+
+const U32 RenderOrder::InvalidIndex;
+const U32 RenderOrder::RadixRatio;
+
+RenderOrder::RenderOrder()
+	: mKeys()
+	, mRenderables()
+	, mRemoved(0)
+	, mVersion(0)
+	, mDirty()
+	, mDirtyMutex()
+	, mPlaced()
+	, mSortKeys()
+	, mSortRenderables()
+{
+}
+
+void RenderOrder::insert(RenderableComponent* renderable)
+{
+	ASSERT(renderable != nullptr);
+	ASSERT(renderable->mOrderIndex == InvalidIndex);
+
+	// Added at the end with the highest key : the array stays sorted until the update places it
+	const U32 index = mRenderables.size();
+	mKeys.push_back(0xFFFFFFFFFFFFFFFFULL);
+	mRenderables.push_back(renderable);
+	renderable->mOrderIndex = index;
+	renderable->mOrderDirty = true;
+	mDirty.push_back(index);
+	mVersion++;
+}
+
+void RenderOrder::remove(RenderableComponent* renderable)
+{
+	ASSERT(renderable != nullptr);
+	ASSERT(renderable->mOrderIndex < mRenderables.size());
+	ASSERT(mRenderables[renderable->mOrderIndex] == renderable);
+
+	// The hole is filled by the next update, the dirty list skips it
+	mRenderables[renderable->mOrderIndex] = nullptr;
+	mRemoved++;
+	mVersion++;
+	renderable->mOrderIndex = InvalidIndex;
+	renderable->mOrderDirty = false;
+}
+
+void RenderOrder::invalidate(RenderableComponent* renderable)
+{
+	ASSERT(renderable != nullptr);
+
+	// Not spawned yet, or already invalidated
+	if (renderable->mOrderIndex == InvalidIndex || renderable->mOrderDirty)
+	{
+		return;
+	}
+	renderable->mOrderDirty = true;
+	mDirtyMutex.lock();
+	mDirty.push_back(renderable->mOrderIndex);
+	mDirtyMutex.unlock();
+}
+
+void RenderOrder::update()
+{
+	mPlaced.clear();
+	if (mDirty.empty() && mRemoved == 0)
+	{
+		return;
+	}
+
+	// The indices of the dirty list are not valid after the compaction
+	for (U32 index : mDirty)
+	{
+		RenderableComponent* renderable = mRenderables[index];
+		if (renderable != nullptr)
+		{
+			renderable->mOrderDirty = false;
+			mPlaced.push_back(renderable);
+		}
+	}
+	mDirty.clear();
+	if (mRemoved > 0)
+	{
+		compact();
+	}
+
+	// Insertion is cheap while few renderables move by a few places only
+	// When many keys changed, or when the shifts cost as much as sorting everything, the radix sort does the job
+	const U32 maxMoves = mRenderables.size();
+	if (mPlaced.size() > maxMoves / RadixRatio)
+	{
+		sortAll();
+		return;
+	}
+	U32 moves = 0;
+	for (RenderableComponent* renderable : mPlaced)
+	{
+		moves += place(renderable->mOrderIndex, computeKey(renderable->getGlobalZ(), renderable->getGlobalPosition().y));
+		if (moves > maxMoves)
+		{
+			sortAll();
+			break;
+		}
+	}
+}
+
+U32 RenderOrder::getCount() const
+{
+	return mRenderables.size() - mRemoved;
+}
+
+U32 RenderOrder::getDirtyCount() const
+{
+	return mDirty.size();
+}
+
+U32 RenderOrder::getVersion() const
+{
+	return mVersion;
+}
+
+const std::vector<RenderableComponent*>& RenderOrder::getUpdated() const
+{
+	return mPlaced;
+}
+
+RenderOrder::Iterator RenderOrder::begin() const
+{
+	return mRenderables.begin();
+}
+
+RenderOrder::Iterator RenderOrder::end() const
+{
+	return mRenderables.end();
+}
+
+U64 RenderOrder::computeKey(F32 z, F32 y)
+{
+	return (static_cast<U64>(toOrderedBits(z)) << 32) | static_cast<U64>(toOrderedBits(y));
+}
+
+void RenderOrder::compact()
+{
+	// Stable : the order of the remaining renderables is kept
+	U32 count = 0;
+	for (U32 i = 0; i < mRenderables.size(); i++)
+	{
+		RenderableComponent* renderable = mRenderables[i];
+		if (renderable != nullptr)
+		{
+			mKeys[count] = mKeys[i];
+			mRenderables[count] = renderable;
+			renderable->mOrderIndex = count;
+			count++;
+		}
+	}
+	mKeys.resize(count);
+	mRenderables.resize(count);
+	mRemoved = 0;
+}
+
+U32 RenderOrder::place(U32 index, U64 key)
+{
+	// Insertion sort step : the others are sorted, shift them until the key fits
+	RenderableComponent* renderable = mRenderables[index];
+	const U32 start = index;
+	while (index > 0 && mKeys[index - 1] > key)
+	{
+		mKeys[index] = mKeys[index - 1];
+		mRenderables[index] = mRenderables[index - 1];
+		mRenderables[index]->mOrderIndex = index;
+		index--;
+	}
+	const U32 last = mRenderables.size() - 1;
+	while (index < last && mKeys[index + 1] < key)
+	{
+		mKeys[index] = mKeys[index + 1];
+		mRenderables[index] = mRenderables[index + 1];
+		mRenderables[index]->mOrderIndex = index;
+		index++;
+	}
+	mKeys[index] = key;
+	mRenderables[index] = renderable;
+	renderable->mOrderIndex = index;
+	if (index != start)
+	{
+		mVersion++;
+	}
+	return (index > start) ? index - start : start - index;
+}
+
+void RenderOrder::sortAll()
+{
+	const U32 count = mRenderables.size();
+	U32 histograms[8][256];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (U32 i = 0; i < count; i++)
+	{
+		const U64 key = computeKey(mRenderables[i]->getGlobalZ(), mRenderables[i]->getGlobalPosition().y);
+		mKeys[i] = key;
+		for (U32 pass = 0; pass < 8; pass++)
+		{
+			histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	// LSD radix sort, one byte per pass : stable, so the equal keys keep their order
+	mSortKeys.resize(count);
+	mSortRenderables.resize(count);
+	for (U32 pass = 0; pass < 8 && count > 0; pass++)
+	{
+		const U32 shift = pass * 8;
+		U32* histogram = histograms[pass];
+
+		// Every key has the same byte : nothing to do (few different z for example)
+		if (histogram[(mKeys[0] >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		U32 offset = 0;
+		for (U32 i = 0; i < 256; i++)
+		{
+			const U32 size = histogram[i];
+			histogram[i] = offset;
+			offset += size;
+		}
+		for (U32 i = 0; i < count; i++)
+		{
+			const U32 destination = histogram[(mKeys[i] >> shift) & 0xFF]++;
+			mSortKeys[destination] = mKeys[i];
+			mSortRenderables[destination] = mRenderables[i];
+		}
+		std::swap(mKeys, mSortKeys);
+		std::swap(mRenderables, mSortRenderables);
+	}
+	mSortRenderables.clear();
+
+	for (U32 i = 0; i < count; i++)
+	{
+		mRenderables[i]->mOrderIndex = i;
+	}
+	mVersion++;
+}
+
+U32 RenderOrder::toOrderedBits(F32 value)
+{
+	// IEEE 754 bits flipped so that the integers compare like the floats
+	U32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return ((bits & 0x80000000) != 0) ? ~bits : (bits | 0x80000000);
+}
+
+} // namespace oe
@@ -0,0 +1,79 @@
+#ifndef OE_RENDERORDER_HPP
+#define OE_RENDERORDER_HPP
+
+#include "../../System/Prerequisites.hpp"
+#include "../../System/Thread.hpp"
+
+#include <vector>
+
+namespace oe
+{
+
+class RenderableComponent;
+
+// Draw order of the renderables : by z, then by y inside a same z
+// Each renderable has a key packing its (z, y), the renderables are kept sorted by key
+// The renderables whose node moved are placed again by insertion, as they usually move by a few places only
+// When the insertions shift too many renderables, every key is computed again and sorted with a radix sort
+class RenderOrder
+{
+	public:
+		using Iterator = std::vector<RenderableComponent*>::const_iterator;
+
+		static const U32 InvalidIndex = 0xFFFFFFFF;
+
+		RenderOrder();
+
+		void insert(RenderableComponent* renderable);
+		void remove(RenderableComponent* renderable);
+
+		// The node of the renderable moved : its key is computed again by the next update
+		// Can be called for different renderables at the same time
+		void invalidate(RenderableComponent* renderable);
+
+		// Sort the renderables that were inserted or invalidated since the last update
+		void update();
+
+		U32 getCount() const;
+		U32 getDirtyCount() const;
+		U32 getVersion() const; // Changes with the order
+
+		// Renderables inserted or invalidated before the last update, valid until the next remove
+		const std::vector<RenderableComponent*>& getUpdated() const;
+
+		Iterator begin() const;
+		Iterator end() const;
+
+		// Key of a (z, y) pair : sorting the keys as integers sorts by z, then by y
+		static U64 computeKey(F32 z, F32 y);
+
+	private:
+		void compact();
+		U32 place(U32 index, U64 key); // Number of shifts
+		void sortAll(); // Compacted and without dirty renderables
+
+		static U32 toOrderedBits(F32 value);
+
+		// Above Count / RadixRatio changed keys, sortAll is used directly
+		static const U32 RadixRatio = 4;
+
+	private:
+		// Sorted by key between two updates, except the renderables inserted since the last one
+		std::vector<U64> mKeys;
+		std::vector<RenderableComponent*> mRenderables; // nullptr : removed since the last update
+		U32 mRemoved;
+		U32 mVersion;
+
+		// Indices in the arrays above, which stay stable until the next update
+		std::vector<U32> mDirty;
+		Mutex mDirtyMutex;
+		std::vector<RenderableComponent*> mPlaced; // Last update
+
+		// Buffers of the radix sort
+		std::vector<U64> mSortKeys;
+		std::vector<RenderableComponent*> mSortRenderables;
+};
+
+} // namespace oe
+
+#endif // OE_RENDERORDER_HPP
@@ -1,16 +1,41 @@
 #include "RenderSystem.hpp"
 #include "../../System/Log.hpp"
+#include "../../System/Profiler.hpp"
 #include <SFML/Graphics/Sprite.hpp>
 
+#include <algorithm>
+
 namespace oe
 {
 
 RenderSystem::RenderSystem()
 	: mTexture()
 	, mRenderables()
+	, mCulling()
+	, mParticles()
+	, mAnimators()
+	, mSprites()
+	, mBatches()
+	, mBatchVertices()
+	, mBatchSlots()
+	, mOrderVersion(0)
+	, mSpriteVersion(0)
+	, mCullingVersion(0)
+	, mBatchesBuilt(false)
+	, mDebugDraw()
+	, mView()
 	, mBackgroundColor(Color::Black)
-	, mNeedUpdateOrderZ(true)
-	, mNeedUpdateOrderY(true)
+	, mStats()
+{
+}
+
+RenderSystem::Stats::Stats()
+	: drawCalls(0)
+	, vertices(0)
+	, sprites(0)
+	, visible(0)
+	, culled(0)
+	, batchRebuilds(0)
 {
 }
 
@@ -18,18 +43,14 @@ void RenderSystem::registerRenderable(RenderableComponent* renderable)
 {
 	ASSERT(renderable != nullptr);
 	mRenderables.insert(renderable);
-
-	// Reorder the sprite
-	mNeedUpdateOrderZ = true;
-	mNeedUpdateOrderY = true;
-} 
+	mCulling.insert(renderable);
+}
 
 void RenderSystem::unregisterRenderable(RenderableComponent* renderable)
 {
 	ASSERT(renderable != nullptr);
 	mRenderables.remove(renderable);
-
-	// Don't need to reorder here
+	mCulling.remove(renderable);
 }
 
 void RenderSystem::registerParticle(ParticleComponent* particle)
@@ -57,12 +78,27 @@ void RenderSystem::unregisterAnimator(AnimatorComponent* animator)
 }
 
 void RenderSystem::update(Time dt)
+{
+	clearDebugDraw();
+	updateParticles(dt);
+	updateAnimators(dt);
+}
+
+void RenderSystem::clearDebugDraw()
 {
 	mDebugDraw.clear();
+}
+
+void RenderSystem::updateParticles(Time dt)
+{
 	for (auto& particle : mParticles)
 	{
 		particle->update(dt);
 	}
+}
+
+void RenderSystem::updateAnimators(Time dt)
+{
 	for (auto& animator : mAnimators)
 	{
 		animator->update(dt);
@@ -81,14 +117,20 @@ void RenderSystem::setBackgroundColor(const Color& color)
 	mBackgroundColor = color;
 }
 
-void RenderSystem::needUpdateOrderZ()
+void RenderSystem::invalidateOrder(RenderableComponent* renderable)
 {
-	mNeedUpdateOrderZ = true;
+	mRenderables.invalidate(renderable);
 }
 
-void RenderSystem::needUpdateOrderY()
+void RenderSystem::updateOrder()
 {
-	mNeedUpdateOrderY = true;
+	mRenderables.update();
+	mCulling.update(mRenderables.getUpdated());
+}
+
+const RenderOrder& RenderSystem::getOrder() const
+{
+	return mRenderables;
 }
 
 View& RenderSystem::getView()
@@ -96,52 +138,58 @@ View& RenderSystem::getView()
 	return mView;
 }
 
+SpriteStorage& RenderSystem::getSprites()
+{
+	return mSprites;
+}
+
+const RenderSystem::Stats& RenderSystem::getStats() const
+{
+	return mStats;
+}
+
 void RenderSystem::preRender()
 {
-	// Reorder only on Z axis
-	if (mNeedUpdateOrderZ)
-	{
-		std::sort(mRenderables.begin(), mRenderables.end(), RenderSystem::orderZ);
-		mNeedUpdateOrderZ = false;
+	// Vertices of the sprites that moved since the last frame
+	mSprites.update();
 
-		// As we reordered Z we need to reorder Y
-		mNeedUpdateOrderY = true;
-	}
+	// Place again the renderables that were added or moved since the last frame
+	updateOrder();
 
-	// Reorder only on Y axis
-	if (mNeedUpdateOrderY)
-	{
-		auto begin = mRenderables.begin();
-		float currentZ = -99999.f;
-		for (auto itr = mRenderables.begin(); itr != mRenderables.end(); ++itr)
-		{
-			RenderableComponent* r = (*itr);
-			ASSERT(r != nullptr);
-			F32 z = r->getGlobalZ();
-			ASSERT(currentZ <= z);
-			if (currentZ < z)
-			{
-				std::sort(begin, itr, RenderSystem::orderY);
-				currentZ = z;
-				begin = itr + 1;
-			}
-		}
-		mNeedUpdateOrderY = false;
-	}
+	// Only the renderables in the view are batched and drawn
+	mCulling.query(mView.getBounds());
+	mStats.visible = mCulling.getVisibleCount();
+	mStats.culled = mCulling.getCount() - mStats.visible;
+	ProfileCounter("RenderSystem::visible", mStats.visible);
+	ProfileCounter("RenderSystem::culled", mStats.culled);
+
+	updateBatches();
 }
 
 void RenderSystem::render()
 {
 	mTexture.clear(toSF(mBackgroundColor));
 	mTexture.setView(mView.getHandle());
-	for (RenderableComponent* renderable : mRenderables)
+	mStats.drawCalls = 0;
+	mStats.vertices = 0;
+	for (const Batch& batch : mBatches)
 	{
-		ASSERT(renderable != nullptr);
-		if (renderable->isVisible())
+		if (batch.renderable != nullptr)
+		{
+			if (batch.renderable->isVisible())
+			{
+				batch.renderable->render(mTexture);
+				mStats.drawCalls++;
+			}
+		}
+		else
 		{
-			renderable->render(mTexture);
+			mTexture.draw(&mBatchVertices[batch.begin], batch.count, sf::Quads, sf::RenderStates(batch.texture));
+			mStats.drawCalls++;
+			mStats.vertices += batch.count;
 		}
 	}
+	mStats.sprites = mBatchVertices.size() / 4;
 	mDebugDraw.render(mTexture);
 	mTexture.display();
 }
@@ -166,18 +214,72 @@ void RenderSystem::postRender(sf::RenderTarget& target)
 	}
 }
 
-bool RenderSystem::orderZ(RenderableComponent* a, RenderableComponent* b)
+void RenderSystem::updateBatches()
 {
-	ASSERT(a != nullptr);
-	ASSERT(b != nullptr);
-	return a->getGlobalZ() < b->getGlobalZ();
+	if (!mBatchesBuilt || mOrderVersion != mRenderables.getVersion() || mSpriteVersion != mSprites.getVersion() || mCullingVersion != mCulling.getVersion())
+	{
+		rebuildBatches();
+		return;
+	}
+
+	// Same order, textures and visible set : only the vertices of the sprites that moved are copied
+	for (SpriteStorage::Id id : mSprites.getUpdatedIds())
+	{
+		if (id < mBatchSlots.size() && mBatchSlots[id] != SpriteStorage::InvalidId && mSprites.contains(id))
+		{
+			const sf::Vertex* vertices = mSprites.getVertices(mSprites.getIndex(id));
+			std::copy(vertices, vertices + 4, mBatchVertices.begin() + mBatchSlots[id]);
+		}
+	}
 }
 
-bool RenderSystem::orderY(RenderableComponent* a, RenderableComponent* b)
+void RenderSystem::rebuildBatches()
 {
-	ASSERT(a != nullptr);
-	ASSERT(b != nullptr);
-	return a->getGlobalPosition().y < b->getGlobalPosition().y;
+	mBatches.clear();
+	mBatchVertices.clear();
+	mBatchSlots.clear();
+	for (RenderableComponent* renderable : mRenderables)
+	{
+		ASSERT(renderable != nullptr);
+		if (!mCulling.isVisible(renderable))
+		{
+			continue;
+		}
+
+		const SpriteStorage::Id id = renderable->getSpriteId();
+		if (id == SpriteStorage::InvalidId)
+		{
+			mBatches.push_back({ renderable, nullptr, 0, 0 });
+			continue;
+		}
+
+		const U32 index = mSprites.getIndex(id);
+		const sf::Texture* texture = mSprites.getTextureAt(index);
+		if (texture == nullptr || !mSprites.isVisibleAt(index))
+		{
+			continue;
+		}
+
+		// Sprites only use the default blend mode : the texture is enough to merge them
+		if (mBatches.empty() || mBatches.back().renderable != nullptr || mBatches.back().texture != texture)
+		{
+			mBatches.push_back({ nullptr, texture, static_cast<U32>(mBatchVertices.size()), 0 });
+		}
+		if (id >= mBatchSlots.size())
+		{
+			mBatchSlots.resize(id + 1, SpriteStorage::InvalidId);
+		}
+		mBatchSlots[id] = mBatchVertices.size();
+		const sf::Vertex* vertices = mSprites.getVertices(index);
+		mBatchVertices.insert(mBatchVertices.end(), vertices, vertices + 4);
+		mBatches.back().count += 4;
+	}
+
+	mOrderVersion = mRenderables.getVersion();
+	mSpriteVersion = mSprites.getVersion();
+	mCullingVersion = mCulling.getVersion();
+	mBatchesBuilt = true;
+	mStats.batchRebuilds++;
 }
 
 } // namespace oe
\ No newline at end of file
@@ -5,12 +5,18 @@
 #include "../Components/ParticleComponent.hpp"
 #include "../Components/AnimatorComponent.hpp"
 #include "../ComponentList.hpp"
+#include "CullingGrid.hpp"
+#include "RenderOrder.hpp"
+#include "SpriteStorage.hpp"
 
 #include "../../System/DebugDraw.hpp"
 #include "../../System/View.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <vector>
 
 namespace oe
 {
@@ -18,6 +24,18 @@ namespace oe
 class RenderSystem
 {
 	public:
+		struct Stats
+		{
+			Stats();
+
+			U32 drawCalls; // Last frame, a renderable that is not a sprite counts as one
+			U32 vertices; // Last frame, sprites only
+			U32 sprites; // Last frame
+			U32 visible; // Last frame, renderables in the view
+			U32 culled; // Last frame, renderables out of the view
+			U32 batchRebuilds; // Since the creation
+		};
+
 		RenderSystem();
 
 		void registerRenderable(RenderableComponent* renderable);
@@ -32,27 +50,60 @@ class RenderSystem
 		void update(Time dt);
 		void render(sf::RenderTarget& target);
 
+		// Parts of update, used by the update phase of the World
+		void clearDebugDraw();
+		void updateParticles(Time dt);
+		void updateAnimators(Time dt);
+
 		void setBackgroundColor(const Color& color);
 
-		void needUpdateOrderZ();
-		void needUpdateOrderY();
+		// The z, the y or the bounds of the renderable changed : it is placed again by the next render
+		void invalidateOrder(RenderableComponent* renderable);
+
+		// Part of render, places the renderables invalidated since the last call
+		void updateOrder();
+		const RenderOrder& getOrder() const;
 
 		View& getView();
 
+		SpriteStorage& getSprites();
+
+		const Stats& getStats() const;
+
 	private:
 		void preRender();
 		void render();
 		void postRender(sf::RenderTarget& target);
 
-		static bool orderZ(RenderableComponent* a, RenderableComponent* b);
-		static bool orderY(RenderableComponent* a, RenderableComponent* b);
+		void updateBatches();
+		void rebuildBatches();
+
+		// Consecutive sprites sharing a texture, or a renderable drawn by itself
+		struct Batch
+		{
+			RenderableComponent* renderable; // nullptr : sprites
+			const sf::Texture* texture;
+			U32 begin; // First vertex
+			U32 count;
+		};
 
 	private:
 		sf::RenderTexture mTexture;
 
-		RenderableComponentList mRenderables;
+		RenderOrder mRenderables;
+		CullingGrid mCulling;
 		ParticleComponentList mParticles;
 		AnimatorComponentList mAnimators;
+		SpriteStorage mSprites;
+
+		// Built in the render order, kept while the order, the textures and the visible set do not change
+		std::vector<Batch> mBatches;
+		std::vector<sf::Vertex> mBatchVertices;
+		std::vector<U32> mBatchSlots; // Sprite id to its first vertex in mBatchVertices
+		U32 mOrderVersion;
+		U32 mSpriteVersion;
+		U32 mCullingVersion;
+		bool mBatchesBuilt;
 
 		DebugDraw mDebugDraw;
 
@@ -60,8 +111,7 @@ class RenderSystem
 
 		Color mBackgroundColor;
 
-		bool mNeedUpdateOrderZ;
-		bool mNeedUpdateOrderY;
+		Stats mStats;
 };
 
 } // namespace oe
@@ -0,0 +1,324 @@
+#include "SpriteStorage.hpp"
+#include "../Components/SpriteComponent.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+namespace oe
+{
+
+const SpriteStorage::Id SpriteStorage::InvalidId;
+
+SpriteStorage::SpriteStorage()
+	: mIds()
+	, mOwners()
+	, mTransforms()
+	, mVertices()
+	, mBounds()
+	, mTextures()
+	, mTextureRects()
+	, mColors()
+	, mZ()
+	, mVisible()
+	, mDirty()
+	, mIndices()
+	, mFreeIds()
+	, mDirtyIds()
+	, mUpdatedIds()
+	, mDirtyMutex()
+	, mVersion(0)
+{
+}
+
+SpriteStorage::Id SpriteStorage::create(SpriteComponent* owner)
+{
+	ASSERT(owner != nullptr);
+
+	Id id;
+	if (!mFreeIds.empty())
+	{
+		id = mFreeIds.back();
+		mFreeIds.pop_back();
+	}
+	else
+	{
+		id = mIndices.size();
+		mIndices.push_back(InvalidId);
+	}
+
+	mIndices[id] = mIds.size();
+	mIds.push_back(id);
+	mOwners.push_back(owner);
+	mTransforms.push_back(sf::Transform::Identity);
+	mVertices.resize(mVertices.size() + 4);
+	mBounds.push_back(sf::FloatRect());
+	mTextures.push_back(nullptr);
+	mTextureRects.push_back(sf::IntRect());
+	mColors.push_back(sf::Color::White);
+	mZ.push_back(0.0f);
+	mVisible.push_back(1);
+	mDirty.push_back(0);
+	invalidate(id);
+	invalidateZ(id);
+	mVersion++;
+	return id;
+}
+
+void SpriteStorage::destroy(Id id)
+{
+	ASSERT(contains(id));
+
+	// The last sprite takes the place of the removed one
+	const U32 index = mIndices[id];
+	const U32 last = mIds.size() - 1;
+	if (index != last)
+	{
+		mIds[index] = mIds[last];
+		mOwners[index] = mOwners[last];
+		mTransforms[index] = mTransforms[last];
+		for (U32 i = 0; i < 4; i++)
+		{
+			mVertices[index * 4 + i] = mVertices[last * 4 + i];
+		}
+		mBounds[index] = mBounds[last];
+		mTextures[index] = mTextures[last];
+		mTextureRects[index] = mTextureRects[last];
+		mColors[index] = mColors[last];
+		mZ[index] = mZ[last];
+		mVisible[index] = mVisible[last];
+		mDirty[index] = mDirty[last];
+		mIndices[mIds[index]] = index;
+	}
+	mIds.pop_back();
+	mOwners.pop_back();
+	mTransforms.pop_back();
+	mVertices.resize(mVertices.size() - 4);
+	mBounds.pop_back();
+	mTextures.pop_back();
+	mTextureRects.pop_back();
+	mColors.pop_back();
+	mZ.pop_back();
+	mVisible.pop_back();
+	mDirty.pop_back();
+
+	// The dirty list is filtered by the next update
+	mIndices[id] = InvalidId;
+	mFreeIds.push_back(id);
+	mVersion++;
+}
+
+bool SpriteStorage::contains(Id id) const
+{
+	return id < mIndices.size() && mIndices[id] != InvalidId;
+}
+
+void SpriteStorage::setTexture(Id id, const sf::Texture* texture)
+{
+	const U32 index = getIndex(id);
+
+	// Same as sf::Sprite : the first texture sets the rect if there is none
+	if (mTextures[index] == nullptr && texture != nullptr && mTextureRects[index] == sf::IntRect())
+	{
+		mTextureRects[index] = sf::IntRect(0, 0, texture->getSize().x, texture->getSize().y);
+	}
+	if (mTextures[index] != texture)
+	{
+		mTextures[index] = texture;
+		mVersion++;
+	}
+	invalidate(id);
+}
+
+const sf::Texture* SpriteStorage::getTexture(Id id) const
+{
+	return mTextures[getIndex(id)];
+}
+
+void SpriteStorage::setTextureRect(Id id, const sf::IntRect& textureRect)
+{
+	const U32 index = getIndex(id);
+	if (mTextureRects[index] != textureRect)
+	{
+		mTextureRects[index] = textureRect;
+		invalidate(id);
+	}
+}
+
+const sf::IntRect& SpriteStorage::getTextureRect(Id id) const
+{
+	return mTextureRects[getIndex(id)];
+}
+
+void SpriteStorage::setColor(Id id, const sf::Color& color)
+{
+	const U32 index = getIndex(id);
+	if (mColors[index] != color)
+	{
+		mColors[index] = color;
+		invalidate(id);
+	}
+}
+
+const sf::Color& SpriteStorage::getColor(Id id) const
+{
+	return mColors[getIndex(id)];
+}
+
+void SpriteStorage::setVisible(Id id, bool visible)
+{
+	const U32 index = getIndex(id);
+	const U8 value = visible ? 1 : 0;
+	if (mVisible[index] != value)
+	{
+		mVisible[index] = value;
+		mVersion++;
+	}
+}
+
+bool SpriteStorage::isVisible(Id id) const
+{
+	return mVisible[getIndex(id)] != 0;
+}
+
+void SpriteStorage::invalidate(Id id)
+{
+	const U32 index = getIndex(id);
+	if (mDirty[index] == 0)
+	{
+		mDirtyMutex.lock();
+		mDirtyIds.push_back(id);
+		mDirtyMutex.unlock();
+	}
+	mDirty[index] |= DirtyTransform;
+}
+
+void SpriteStorage::invalidateZ(Id id)
+{
+	const U32 index = getIndex(id);
+	if (mDirty[index] == 0)
+	{
+		mDirtyMutex.lock();
+		mDirtyIds.push_back(id);
+		mDirtyMutex.unlock();
+	}
+	mDirty[index] |= DirtyZ;
+}
+
+void SpriteStorage::update()
+{
+	for (Id id : mDirtyIds)
+	{
+		// Destroyed, or reused and already updated
+		if (!contains(id))
+		{
+			continue;
+		}
+		const U32 index = mIndices[id];
+		if ((mDirty[index] & DirtyTransform) != 0)
+		{
+			mTransforms[index] = mOwners[index]->getGlobalTransform();
+			updateVertices(index);
+		}
+		if ((mDirty[index] & DirtyZ) != 0)
+		{
+			mZ[index] = mOwners[index]->getGlobalZ();
+		}
+		mDirty[index] = 0;
+	}
+	std::swap(mDirtyIds, mUpdatedIds);
+	mDirtyIds.clear();
+}
+
+const std::vector<SpriteStorage::Id>& SpriteStorage::getUpdatedIds() const
+{
+	return mUpdatedIds;
+}
+
+U32 SpriteStorage::getVersion() const
+{
+	return mVersion;
+}
+
+void SpriteStorage::render(sf::RenderTarget& target, Id id) const
+{
+	const U32 index = getIndex(id);
+	ASSERT(mDirty[index] == 0);
+	if (mTextures[index] != nullptr)
+	{
+		target.draw(&mVertices[index * 4], 4, sf::Quads, sf::RenderStates(mTextures[index]));
+	}
+}
+
+U32 SpriteStorage::getCount() const
+{
+	return mIds.size();
+}
+
+U32 SpriteStorage::getIndex(Id id) const
+{
+	ASSERT(contains(id));
+	return mIndices[id];
+}
+
+SpriteStorage::Id SpriteStorage::getId(U32 index) const
+{
+	return mIds[index];
+}
+
+SpriteComponent* SpriteStorage::getOwner(U32 index) const
+{
+	return mOwners[index];
+}
+
+const sf::Vertex* SpriteStorage::getVertices(U32 index) const
+{
+	return &mVertices[index * 4];
+}
+
+const sf::Texture* SpriteStorage::getTextureAt(U32 index) const
+{
+	return mTextures[index];
+}
+
+const sf::FloatRect& SpriteStorage::getBoundsAt(U32 index) const
+{
+	return mBounds[index];
+}
+
+F32 SpriteStorage::getZAt(U32 index) const
+{
+	return mZ[index];
+}
+
+bool SpriteStorage::isVisibleAt(U32 index) const
+{
+	return mVisible[index] != 0;
+}
+
+U32 SpriteStorage::getDirtyCount() const
+{
+	return mDirtyIds.size();
+}
+
+void SpriteStorage::updateVertices(U32 index)
+{
+	// Same quad as sf::Sprite, transformed once here instead of at each draw
+	const sf::IntRect& rect = mTextureRects[index];
+	const F32 width = static_cast<F32>(std::abs(rect.width));
+	const F32 height = static_cast<F32>(std::abs(rect.height));
+	const F32 left = static_cast<F32>(rect.left);
+	const F32 right = left + rect.width;
+	const F32 top = static_cast<F32>(rect.top);
+	const F32 bottom = top + rect.height;
+
+	const sf::Transform& transform = mTransforms[index];
+	const sf::Color& color = mColors[index];
+	sf::Vertex* vertices = &mVertices[index * 4];
+	vertices[0] = sf::Vertex(transform.transformPoint(0.0f, 0.0f), color, sf::Vector2f(left, top));
+	vertices[1] = sf::Vertex(transform.transformPoint(width, 0.0f), color, sf::Vector2f(right, top));
+	vertices[2] = sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom));
+	vertices[3] = sf::Vertex(transform.transformPoint(0.0f, height), color, sf::Vector2f(left, bottom));
+	mBounds[index] = transform.transformRect(sf::FloatRect(0.0f, 0.0f, width, height));
+}
+
+} // namespace oe
@@ -0,0 +1,108 @@
+#ifndef OE_SPRITESTORAGE_HPP
+#define OE_SPRITESTORAGE_HPP
+
+#include "../../System/Prerequisites.hpp"
+#include "../../System/Thread.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace oe
+{
+
+class SpriteComponent;
+
+// Data of every SpriteComponent of a world, stored by field in dense arrays (SoA)
+// Components keep an id, the systems iterate over the indices [0, getCount())
+// Removing a sprite moves the last one in its place : ids are stable, indices are not
+class SpriteStorage
+{
+	public:
+		using Id = U32;
+		static const Id InvalidId = 0xFFFFFFFF;
+
+		SpriteStorage();
+
+		Id create(SpriteComponent* owner);
+		void destroy(Id id);
+		bool contains(Id id) const;
+
+		void setTexture(Id id, const sf::Texture* texture);
+		const sf::Texture* getTexture(Id id) const;
+		void setTextureRect(Id id, const sf::IntRect& textureRect);
+		const sf::IntRect& getTextureRect(Id id) const;
+		void setColor(Id id, const sf::Color& color);
+		const sf::Color& getColor(Id id) const;
+		void setVisible(Id id, bool visible);
+		bool isVisible(Id id) const;
+
+		// The node of the owner moved : its vertices are computed again by the next update
+		// Can be called for different sprites at the same time
+		void invalidate(Id id);
+		void invalidateZ(Id id);
+
+		// Refresh the transform, z and vertices of the invalidated sprites only
+		void update();
+
+		// Sprites refreshed by the last update, some of them can be destroyed since
+		const std::vector<Id>& getUpdatedIds() const;
+
+		// Changes when a sprite is created, destroyed, or changes its texture or visibility
+		U32 getVersion() const;
+
+		void render(sf::RenderTarget& target, Id id) const;
+
+		// Systems side
+		U32 getCount() const;
+		U32 getIndex(Id id) const;
+		Id getId(U32 index) const;
+		SpriteComponent* getOwner(U32 index) const;
+		const sf::Vertex* getVertices(U32 index) const; // 4 vertices (quad) in global space
+		const sf::Texture* getTextureAt(U32 index) const;
+		const sf::FloatRect& getBoundsAt(U32 index) const; // Global space
+		F32 getZAt(U32 index) const;
+		bool isVisibleAt(U32 index) const;
+		U32 getDirtyCount() const;
+
+	private:
+		void updateVertices(U32 index);
+
+		static const U8 DirtyTransform = 1;
+		static const U8 DirtyZ = 2;
+
+	private:
+		// Dense arrays : one entry per sprite
+		std::vector<Id> mIds;
+		std::vector<SpriteComponent*> mOwners;
+		std::vector<sf::Transform> mTransforms;
+		std::vector<sf::Vertex> mVertices;
+		std::vector<sf::FloatRect> mBounds;
+		std::vector<const sf::Texture*> mTextures;
+		std::vector<sf::IntRect> mTextureRects;
+		std::vector<sf::Color> mColors;
+		std::vector<F32> mZ;
+		std::vector<U8> mVisible;
+		std::vector<U8> mDirty;
+
+		// Sparse array : id to index
+		std::vector<U32> mIndices;
+		std::vector<Id> mFreeIds;
+
+		std::vector<Id> mDirtyIds;
+		std::vector<Id> mUpdatedIds;
+		Mutex mDirtyMutex;
+
+		// Can be changed by the entities updated in parallel
+		std::atomic<U32> mVersion;
+};
+
+} // namespace oe
+
+#endif // OE_SPRITESTORAGE_HPP
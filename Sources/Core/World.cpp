@@ -5,14 +5,17 @@ namespace oe
 
 World::World(Application& application)
 	: mApplication(application)
+	, mEntityAllocator()
+	, mChunks()
+	, mSlotCount(0)
+	, mFreeSlot(InvalidSlot)
+	, mKillMutex()
 	, mPlaying(true)
 	, mUpdateTime(Time::Zero)
+	, mSystems()
+	, mWaves()
+	, mSystemsScheduled(false)
 {
-	for (U32 i = 0; i < mMaxEntities; i++)
-	{
-		mEntities[i] = nullptr;
-	}
-
 	#ifdef OE_PLATFORM_ANDROID
 	mWindowLostFocus.connect(mApplication.getWindow().onWindowLostFocus, [this](const Window* window)
 	{
@@ -30,7 +33,17 @@ World::World(Application& application)
 	});
 	#endif
 
-	mRenderSystem.getView().reset(0.0f, 0.0f, mApplication.getWindow().getSize().x, mApplication.getWindow().getSize().y);
+	if (!mApplication.isHeadless())
+	{
+		mRenderSystem.getView().reset(0.0f, 0.0f, mApplication.getWindow().getSize().x, mApplication.getWindow().getSize().y);
+	}
+
+	// Timer callbacks can do anything
+	// Particles only read the nodes for their emitters, animators change sprites : both run together after the entities
+	addSystem("Timers", Access::All, Access::All, [this](Time dt) { mTimeSystem.update(dt); });
+	addSystem("Entities", Access::Entities | Access::Transforms, Access::Entities | Access::Transforms | Access::Renderables, [this](Time dt) { updateEntities(dt); });
+	addSystem("Particles", Access::Transforms | Access::Particles, Access::Particles, [this](Time dt) { mRenderSystem.updateParticles(dt); });
+	addSystem("Animators", Access::Renderables, Access::Renderables, [this](Time dt) { mRenderSystem.updateAnimators(dt); });
 }
 
 Application& World::getApplication()
@@ -38,20 +51,34 @@ Application& World::getApplication()
 	return mApplication;
 }
 
+void World::addSystem(const std::string& name, U32 reads, U32 writes, SystemFunction function)
+{
+	ASSERT(function != nullptr);
+	mSystems.push_back({ name, reads | writes, writes, function, 0 });
+	mSystemsScheduled = false;
+}
+
+U32 World::getSystemWaveCount()
+{
+	scheduleSystems();
+	return mWaves.size();
+}
+
 void World::update(Time dt)
 {
 	update();
 
 	if (isPlaying())
 	{
+		// Start of the simulation step, used to interpolate the rendering
+		savePreviousPositions();
+
 		// Apply speed factor
 		mUpdateTime = dt * mTimeSystem.getSpeedFactor();
 
-		// Update timer
-		mTimeSystem.update(mUpdateTime);
-
-		// Update animations and particles
-		mRenderSystem.update(mUpdateTime);
+		// Timers, entities, animations and particles
+		mRenderSystem.clearDebugDraw();
+		runSystems(mUpdateTime);
 	}
 }
 
@@ -73,7 +100,28 @@ void World::update()
 
 void World::render(sf::RenderTarget& target)
 {
+	if (!isPlaying())
+	{
+		mRenderSystem.render(target);
+		return;
+	}
+
+	// Entities are drawn between their two last simulated positions, then put back
+	const F32 alpha = mApplication.getInterpolation();
+	FrameVector<Entity*> interpolated;
+	for (const EntityHandle& handle : mEntitiesPlaying)
+	{
+		Entity* entity = handle.get();
+		if (entity != nullptr && entity->beginInterpolation(alpha))
+		{
+			interpolated.push_back(entity);
+		}
+	}
 	mRenderSystem.render(target);
+	for (Entity* entity : interpolated)
+	{
+		entity->endInterpolation();
+	}
 }
 
 const Time& World::getUpdateTime() const
@@ -85,34 +133,28 @@ void World::killEntity(const EntityHandle& handle)
 {
 	if (handle.isValid())
 	{
+		Lock lock(mKillMutex);
 		mEntitiesKilled.insert(handle);
 	}
 }
 
 void World::killEntity(const Entity* entity)
 {
-	for (const EntityHandle& h : mEntitiesPlaying)
-	{
-		if (h.getEntityId() == entity->getId())
-		{
-			killEntity(h);
-			return;
-		}
-	}
-	for (const EntityHandle& h : mEntitiesSpawning)
-	{
-		if (h.getEntityId() == entity->getId())
-		{
-			killEntity(h);
-			return;
-		}
-	}
-	for (const EntityHandle& h : mEntitiesKilled)
+	ASSERT(entity != nullptr);
+	ASSERT(&entity->mWorld == this);
+	killEntity(entity->getHandle());
+}
+
+void World::killEntities(const EntityHandle* handles, U32 count)
+{
+	// Everything is destroyed together by the next update
+	Lock lock(mKillMutex);
+	mEntitiesKilled.reserve(mEntitiesKilled.size() + count);
+	for (U32 i = 0; i < count; i++)
 	{
-		if (h.getEntityId() == entity->getId())
+		if (handles[i].isValid())
 		{
-			killEntity(h);
-			return;
+			mEntitiesKilled.insert(handles[i]);
 		}
 	}
 }
@@ -127,6 +169,16 @@ U32 World::getEntitiesPlaying() const
 	return mEntitiesPlaying.size();
 }
 
+U32 World::getSlotCapacity() const
+{
+	return mChunks.size() * ChunkSize;
+}
+
+const World::EntityAllocator::Stats& World::getEntityAllocatorStats() const
+{
+	return mEntityAllocator.getStats();
+}
+
 RenderSystem& World::getRenderSystem()
 {
 	return mRenderSystem;
@@ -180,31 +232,21 @@ void World::clear()
 	// TODO : World::clear()
 }
 
-U32 World::getFreeHandleIndex() const
-{
-	for (U32 i = 0; i < mMaxEntities; i++)
-	{
-		if (mEntities[i] == nullptr)
-		{
-			return i;
-		}
-	}
-	ASSERT(false); // Max entities reached
-	return 0;
-}
-
-EntityHandle World::createEntity(Entity* entity)
+EntityHandle World::createEntity(Entity* entity, EntityDeleter deleter)
 {
-	U32 index = getFreeHandleIndex();
-
 	ASSERT(entity != nullptr);
-	ASSERT(index < mMaxEntities);
-
-	mEntities[index] = entity;
+	ASSERT(deleter != nullptr);
+
+	U32 index = allocateSlot();
+	Slot& slot = getSlot(index);
+	slot.entity = entity;
+	slot.deleter = deleter;
+	entity->mHandleIndex = index;
+	entity->mHandleGeneration = slot.generation;
 	entity->onCreate();
 	entity->createComponents();
 
-	EntityHandle handle(this, *entity, index);
+	EntityHandle handle(this, index, slot.generation);
 	mEntitiesSpawning.insert(handle);
 	return handle;
 }
@@ -220,11 +262,9 @@ void World::destroyEntities()
 			entity->setPlaying(false);
 			entity->onDestroy();
 
-			U32 index = (*itr).getHandleIndex();
-			ASSERT(index < mMaxEntities);
-
-			delete mEntities[index]; // TODO : Allocator
-			mEntities[index] = nullptr;
+			const U32 index = (*itr).getHandleIndex();
+			getSlot(index).deleter(mEntityAllocator, entity);
+			freeSlot(index);
 		}
 	}
 	mEntitiesKilled.clear();
@@ -238,6 +278,7 @@ void World::spawnEntities()
 		if (entity != nullptr)
 		{
 			entity->onSpawn();
+			entity->savePreviousPosition(); // Not interpolated from its creation
 			entity->setPlaying(true);
 			entity->spawnComponents();
 			mEntitiesPlaying.insert(*itr);
@@ -246,10 +287,121 @@ void World::spawnEntities()
 	mEntitiesSpawning.clear();
 }
 
-Entity* World::getEntityFromHandleIndex(U32 handleIndex) const
+void World::updateEntities(Time dt)
 {
-	ASSERT(handleIndex < mMaxEntities);
-	return mEntities[handleIndex];
+	// One after the other : the game logic of an entity can read and change the others
+	for (const EntityHandle& handle : mEntitiesPlaying)
+	{
+		Entity* entity = handle.get();
+		if (entity != nullptr)
+		{
+			entity->update(dt);
+		}
+	}
+}
+
+void World::savePreviousPositions()
+{
+	for (const EntityHandle& handle : mEntitiesPlaying)
+	{
+		Entity* entity = handle.get();
+		if (entity != nullptr)
+		{
+			entity->savePreviousPosition();
+		}
+	}
+}
+
+void World::scheduleSystems()
+{
+	if (mSystemsScheduled)
+	{
+		return;
+	}
+
+	// A system runs in the wave after the last system it conflicts with
+	mWaves.clear();
+	const U32 count = mSystems.size();
+	for (U32 i = 0; i < count; i++)
+	{
+		System& system = mSystems[i];
+		system.wave = 0;
+		for (U32 j = 0; j < i; j++)
+		{
+			const System& previous = mSystems[j];
+			if ((system.writes & previous.reads) != 0 || (system.reads & previous.writes) != 0)
+			{
+				system.wave = std::max(system.wave, previous.wave + 1);
+			}
+		}
+		if (system.wave >= mWaves.size())
+		{
+			mWaves.resize(system.wave + 1);
+		}
+		mWaves[system.wave].push_back(i);
+	}
+	mSystemsScheduled = true;
+}
+
+void World::runSystems(Time dt)
+{
+	scheduleSystems();
+	JobSystem& jobs = mApplication.getJobSystem();
+	for (const std::vector<U32>& wave : mWaves)
+	{
+		if (wave.size() == 1 || jobs.getThreadCount() == 1)
+		{
+			for (U32 index : wave)
+			{
+				mSystems[index].function(dt);
+			}
+			continue;
+		}
+		JobSystem::Counter counter;
+		for (U32 index : wave)
+		{
+			const SystemFunction& function = mSystems[index].function;
+			jobs.run(counter, [&function, dt]() { function(dt); });
+		}
+		jobs.wait(counter);
+	}
+}
+
+U32 World::allocateSlot()
+{
+	if (mFreeSlot != InvalidSlot)
+	{
+		const U32 index = mFreeSlot;
+		mFreeSlot = getSlot(index).nextFree;
+		return index;
+	}
+
+	if (mSlotCount == getSlotCapacity())
+	{
+		mChunks.emplace_back(new Slot[ChunkSize]);
+	}
+	const U32 index = mSlotCount++;
+	Slot& slot = getSlot(index);
+	slot.entity = nullptr;
+	slot.deleter = nullptr;
+	slot.generation = 1;
+	slot.nextFree = InvalidSlot;
+	return index;
+}
+
+void World::freeSlot(U32 handleIndex)
+{
+	// Every handle to the slot is now invalid
+	Slot& slot = getSlot(handleIndex);
+	slot.entity = nullptr;
+	slot.deleter = nullptr;
+	slot.generation++;
+	if (slot.generation == 0)
+	{
+		slot.generation = 1;
+	}
+	slot.nextFree = mFreeSlot;
+	mFreeSlot = handleIndex;
 }
 
 } // namespace oe
\ No newline at end of file
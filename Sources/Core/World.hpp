@@ -11,6 +11,7 @@
 #include "Systems/AudioSystem.hpp"
 #include "Systems/TimeSystem.hpp"
 
+#include "../System/PoolAllocator.hpp"
 #include "../System/ResourceHolder.hpp"
 #include "../System/SFMLResources.hpp"
 #include "../System/Time.hpp"
@@ -18,16 +19,45 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/Event.hpp>
 
+#include <functional>
+#include <memory>
+
 namespace oe
 {
 
 class World
 {
 	public:
+		// Entities are small objects created and destroyed all along the game
+		using EntityAllocator = PoolAllocator<64 * 1024>;
+
+		// Data used by the systems of the update phase
+		// Systems that write something another one reads or writes are run one after the other, in the order they were added
+		// The others are run at the same time by the job system
+		struct Access
+		{
+			enum : U32
+			{
+				None = 0,
+				Entities = 1 << 0, // Entity::update
+				Transforms = 1 << 1, // Nodes
+				Renderables = 1 << 2, // Sprites, animations, and the render order that moving nodes invalidate
+				Particles = 1 << 3, // Particles of each ParticleComponent, outside of the render order
+				Timers = 1 << 4,
+				Game = 1 << 5, // First bit free for the game
+				All = 0xFFFFFFFF
+			};
+		};
+
+		using SystemFunction = std::function<void(Time dt)>;
+
 		World(Application& application);
 
 		Application& getApplication();
 
+		void addSystem(const std::string& name, U32 reads, U32 writes, SystemFunction function);
+		U32 getSystemWaveCount();
+
 		void update(Time dt);
 		void update();
 		void render(sf::RenderTarget& target);
@@ -38,8 +68,11 @@ class World
 		EntityHandle createEntity();
 		void killEntity(const EntityHandle& handle);
 		void killEntity(const Entity* entity);
+		void killEntities(const EntityHandle* handles, U32 count);
 		U32 getEntitiesCount() const; // Spawning & Playing
 		U32 getEntitiesPlaying() const; // Playing only
+		U32 getSlotCapacity() const;
+		const EntityAllocator::Stats& getEntityAllocatorStats() const;
 
 		RenderSystem& getRenderSystem();
 		TimeSystem& getTimeSystem();
@@ -55,24 +88,56 @@ class World
 		void clear();
 
 	private:
-		U32 getFreeHandleIndex() const;
-		EntityHandle createEntity(Entity* entity);
+		// The slot keeps how to destroy its entity : the allocator needs the real type
+		using EntityDeleter = void(*)(EntityAllocator& allocator, Entity* entity);
+
+		template <typename T>
+		static void destroyEntity(EntityAllocator& allocator, Entity* entity);
+
+		EntityHandle createEntity(Entity* entity, EntityDeleter deleter);
+
+		void updateEntities(Time dt);
+		void savePreviousPositions();
+		void scheduleSystems();
+		void runSystems(Time dt);
 
 		void destroyEntities();
 		void spawnEntities();
 
+		// Generational slot map : a handle is valid while the generation of its slot is the same
+		// Slots are allocated by chunks that never move, freed slots are reused first
+		struct Slot
+		{
+			Entity* entity;
+			EntityDeleter deleter;
+			U32 generation; // Never 0 : 0 is the generation of invalid handles
+			U32 nextFree;
+		};
+
+		U32 allocateSlot();
+		void freeSlot(U32 handleIndex);
+		Slot& getSlot(U32 handleIndex);
+		const Slot& getSlot(U32 handleIndex) const;
+
 		friend class EntityHandle;
-		Entity* getEntityFromHandleIndex(U32 handleIndex) const;
+		Entity* getEntity(U32 handleIndex, U32 generation) const;
+		bool isAlive(U32 handleIndex, U32 generation) const;
 
 	private:
-		static const U32 mMaxEntities = 1024;
+		static const U32 ChunkShift = 10;
+		static const U32 ChunkSize = 1 << ChunkShift;
+		static const U32 InvalidSlot = 0xFFFFFFFF;
 
 		OeSlot(oe::Window, onWindowLostFocus, mWindowLostFocus);
 		OeSlot(oe::Window, onWindowGainedFocus, mWindowGainedFocus);
 
 	private:
 		Application& mApplication;
-		Entity* mEntities[mMaxEntities];
+		EntityAllocator mEntityAllocator;
+		std::vector<std::unique_ptr<Slot[]>> mChunks;
+		U32 mSlotCount;
+		U32 mFreeSlot;
+		Mutex mKillMutex; // Entities can be killed by their update
 		EntityList mEntitiesSpawning;
 		EntityList mEntitiesPlaying;
 		EntityList mEntitiesKilled;
@@ -82,13 +147,56 @@ class World
 
 		RenderSystem mRenderSystem;
 		TimeSystem mTimeSystem;
+
+		struct System
+		{
+			std::string name;
+			U32 reads;
+			U32 writes;
+			SystemFunction function;
+			U32 wave;
+		};
+
+		std::vector<System> mSystems;
+		std::vector<std::vector<U32>> mWaves;
+		bool mSystemsScheduled;
 };
 
 template <typename T>
 EntityHandle World::createEntity()
 {
-	Entity* entity = new T(*this); // TODO : Allocator
-	return createEntity(entity);
+	Entity* entity = mEntityAllocator.create<T>(*this);
+	entity->mType = &EntityType::get<T>();
+	return createEntity(entity, &World::destroyEntity<T>);
+}
+
+template <typename T>
+void World::destroyEntity(EntityAllocator& allocator, Entity* entity)
+{
+	allocator.destroy(static_cast<T*>(entity));
+}
+
+inline World::Slot& World::getSlot(U32 handleIndex)
+{
+	ASSERT(handleIndex < mSlotCount);
+	return mChunks[handleIndex >> ChunkShift][handleIndex & (ChunkSize - 1)];
+}
+
+inline const World::Slot& World::getSlot(U32 handleIndex) const
+{
+	ASSERT(handleIndex < mSlotCount);
+	return mChunks[handleIndex >> ChunkShift][handleIndex & (ChunkSize - 1)];
+}
+
+inline Entity* World::getEntity(U32 handleIndex, U32 generation) const
+{
+	const Slot& slot = getSlot(handleIndex);
+	return (slot.generation == generation) ? slot.entity : nullptr;
+}
+
+inline bool World::isAlive(U32 handleIndex, U32 generation) const
+{
+	return getSlot(handleIndex).generation == generation;
 }
 
 } // namespace oe
@@ -12,12 +12,9 @@ Random Random::mRandom;
 void Random::setSeed(const std::string& seed)
 {
 	mRandom.mSeed = seed;
-	#ifdef _MSC_VER
-	mRandom.mGenerator.seed(std::seed_seq(mRandom.mSeed.begin(), mRandom.mSeed.end()));
-	#else
-	static std::seed_seq seedSeq = std::seed_seq(mRandom.mSeed.begin(), mRandom.mSeed.end());
+	// Not static : each seed must restart the same sequence
+	std::seed_seq seedSeq(mRandom.mSeed.begin(), mRandom.mSeed.end());
 	mRandom.mGenerator.seed(seedSeq);
-	#endif
 }
 
 const std::string& Random::getSeed()
@@ -0,0 +1,296 @@
+#ifndef OE_HEXGRID_HPP
+#define OE_HEXGRID_HPP
+
+#include "Prerequisites.hpp"
+#include "Vector2i.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace oe
+{
+
+// Storage order of the cells
+// - RowMajor : index = x + y * width
+// - Morton : the grid is cut in 8x8 tiles stored in row-major order, and the cells of a tile are stored in Z-order
+//            Neighbors on both axis are then close in memory, which is better for flood fills on big maps
+enum class HexGridLayout
+{
+	RowMajor,
+	Morton
+};
+
+namespace priv
+{
+
+template <HexGridLayout L>
+struct HexGridIndexer;
+
+template <>
+struct HexGridIndexer<HexGridLayout::RowMajor>
+{
+	static U32 getStorageSize(const Vector2i& size)
+	{
+		return (U32)(size.x * size.y);
+	}
+
+	static U32 toIndex(I32 x, I32 y, const Vector2i& size)
+	{
+		return (U32)(x + y * size.x);
+	}
+
+	static Vector2i toCoords(U32 index, const Vector2i& size)
+	{
+		return Vector2i((I32)index % size.x, (I32)index / size.x);
+	}
+};
+
+template <>
+struct HexGridIndexer<HexGridLayout::Morton>
+{
+	static const U32 TileShift = 3;
+	static const U32 TileSize = 1 << TileShift;
+	static const U32 TileMask = TileSize - 1;
+	static const U32 TileCells = TileSize * TileSize;
+
+	static U32 getTilesX(const Vector2i& size)
+	{
+		return ((U32)size.x + TileMask) >> TileShift;
+	}
+
+	static U32 getStorageSize(const Vector2i& size)
+	{
+		return getTilesX(size) * (((U32)size.y + TileMask) >> TileShift) * TileCells;
+	}
+
+	static U32 toIndex(I32 x, I32 y, const Vector2i& size)
+	{
+		U32 tile = ((U32)x >> TileShift) + ((U32)y >> TileShift) * getTilesX(size);
+		return tile * TileCells + interleave((U32)x & TileMask, (U32)y & TileMask);
+	}
+
+	static Vector2i toCoords(U32 index, const Vector2i& size)
+	{
+		U32 tile = index / TileCells;
+		U32 local = index % TileCells;
+		U32 tilesX = getTilesX(size);
+		return Vector2i((I32)(((tile % tilesX) << TileShift) + compact(local)), (I32)(((tile / tilesX) << TileShift) + compact(local >> 1)));
+	}
+
+	static U32 interleave(U32 x, U32 y)
+	{
+		return spread(x) | (spread(y) << 1);
+	}
+
+	// Spread the 3 low bits of v on the even bits
+	static U32 spread(U32 v)
+	{
+		v = (v | (v << 2)) & 0x33;
+		v = (v | (v << 1)) & 0x55;
+		return v;
+	}
+
+	static U32 compact(U32 v)
+	{
+		v &= 0x55;
+		v = (v | (v >> 1)) & 0x33;
+		v = (v | (v >> 2)) & 0x0F;
+		return v;
+	}
+};
+
+} // namespace priv
+
+// Contiguous storage of one value per cell of a map
+// Access is O(1), with bounds checking available through contains() and the get/set with fallback
+template <typename T, HexGridLayout L = HexGridLayout::RowMajor>
+class HexGrid
+{
+	public:
+		using Indexer = priv::HexGridIndexer<L>;
+
+		HexGrid() : mCells(), mSize() {}
+		HexGrid(const Vector2i& size, const T& value = T()) : mCells(), mSize() { create(size, value); }
+
+		void create(const Vector2i& size, const T& value = T())
+		{
+			mSize.set(size);
+			mCells.assign(Indexer::getStorageSize(size), value);
+		}
+
+		void fill(const T& value)
+		{
+			std::fill(mCells.begin(), mCells.end(), value);
+		}
+
+		void clear()
+		{
+			mCells.clear();
+			mSize.set(0, 0);
+		}
+
+		const Vector2i& getSize() const { return mSize; }
+		U32 getCellCount() const { return (U32)(mSize.x * mSize.y); }
+		U32 getStorageSize() const { return mCells.size(); }
+		bool empty() const { return mCells.empty(); }
+
+		bool contains(I32 x, I32 y) const { return 0 <= x && 0 <= y && x < mSize.x && y < mSize.y; }
+		bool contains(const Vector2i& coords) const { return contains(coords.x, coords.y); }
+
+		U32 toIndex(I32 x, I32 y) const { return Indexer::toIndex(x, y, mSize); }
+		U32 toIndex(const Vector2i& coords) const { return Indexer::toIndex(coords.x, coords.y, mSize); }
+		Vector2i toCoords(U32 index) const { return Indexer::toCoords(index, mSize); }
+
+		T& operator[](const Vector2i& coords)
+		{
+			ASSERT(contains(coords));
+			return mCells[toIndex(coords)];
+		}
+
+		const T& operator[](const Vector2i& coords) const
+		{
+			ASSERT(contains(coords));
+			return mCells[toIndex(coords)];
+		}
+
+		T& operator[](U32 index)
+		{
+			ASSERT(index < mCells.size());
+			return mCells[index];
+		}
+
+		const T& operator[](U32 index) const
+		{
+			ASSERT(index < mCells.size());
+			return mCells[index];
+		}
+
+		const T& get(const Vector2i& coords, const T& outside) const
+		{
+			return (contains(coords)) ? mCells[toIndex(coords)] : outside;
+		}
+
+		bool set(const Vector2i& coords, const T& value)
+		{
+			if (contains(coords))
+			{
+				mCells[toIndex(coords)] = value;
+				return true;
+			}
+			return false;
+		}
+
+		T* getData() { return mCells.data(); }
+		const T* getData() const { return mCells.data(); }
+
+	private:
+		std::vector<T> mCells;
+		Vector2i mSize;
+};
+
+// Bit-packed specialization : one bit per cell
+template <HexGridLayout L>
+class HexGrid<bool, L>
+{
+	public:
+		using Indexer = priv::HexGridIndexer<L>;
+
+		HexGrid() : mWords(), mSize(), mStorageSize(0) {}
+		HexGrid(const Vector2i& size, bool value = false) : mWords(), mSize(), mStorageSize(0) { create(size, value); }
+
+		void create(const Vector2i& size, bool value = false)
+		{
+			mSize.set(size);
+			mStorageSize = Indexer::getStorageSize(size);
+			mWords.assign((mStorageSize + 63) >> 6, (value) ? ~0ull : 0ull);
+		}
+
+		void fill(bool value)
+		{
+			std::fill(mWords.begin(), mWords.end(), (value) ? ~0ull : 0ull);
+		}
+
+		void clear()
+		{
+			mWords.clear();
+			mSize.set(0, 0);
+			mStorageSize = 0;
+		}
+
+		const Vector2i& getSize() const { return mSize; }
+		U32 getCellCount() const { return (U32)(mSize.x * mSize.y); }
+		U32 getStorageSize() const { return mStorageSize; }
+		bool empty() const { return mWords.empty(); }
+
+		bool contains(I32 x, I32 y) const { return 0 <= x && 0 <= y && x < mSize.x && y < mSize.y; }
+		bool contains(const Vector2i& coords) const { return contains(coords.x, coords.y); }
+
+		U32 toIndex(I32 x, I32 y) const { return Indexer::toIndex(x, y, mSize); }
+		U32 toIndex(const Vector2i& coords) const { return Indexer::toIndex(coords.x, coords.y, mSize); }
+		Vector2i toCoords(U32 index) const { return Indexer::toCoords(index, mSize); }
+
+		bool operator[](const Vector2i& coords) const
+		{
+			ASSERT(contains(coords));
+			return test(toIndex(coords));
+		}
+
+		bool operator[](U32 index) const
+		{
+			ASSERT(index < mStorageSize);
+			return test(index);
+		}
+
+		bool get(const Vector2i& coords, bool outside) const
+		{
+			return (contains(coords)) ? test(toIndex(coords)) : outside;
+		}
+
+		bool set(const Vector2i& coords, bool value)
+		{
+			if (contains(coords))
+			{
+				set(toIndex(coords), value);
+				return true;
+			}
+			return false;
+		}
+
+		void set(U32 index, bool value)
+		{
+			ASSERT(index < mStorageSize);
+			if (value)
+			{
+				mWords[index >> 6] |= (1ull << (index & 63));
+			}
+			else
+			{
+				mWords[index >> 6] &= ~(1ull << (index & 63));
+			}
+		}
+
+		bool test(U32 index) const
+		{
+			return (mWords[index >> 6] & (1ull << (index & 63))) != 0;
+		}
+
+		// Returns the previous value
+		bool testAndSet(U32 index)
+		{
+			ASSERT(index < mStorageSize);
+			U64& word = mWords[index >> 6];
+			const U64 bit = 1ull << (index & 63);
+			bool previous = (word & bit) != 0;
+			word |= bit;
+			return previous;
+		}
+
+	private:
+		std::vector<U64> mWords;
+		Vector2i mSize;
+		U32 mStorageSize;
+};
+
+} // namespace oe
+
+#endif // OE_HEXGRID_HPP
@@ -0,0 +1,219 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+namespace oe
+{
+
+namespace
+{
+
+// Queue of the current thread : 0 for the threads that are not workers
+thread_local U32 sThisIndex = 0;
+
+} // namespace
+
+JobSystem::Counter::Counter()
+	: mCount(0)
+{
+}
+
+bool JobSystem::Counter::isDone() const
+{
+	return mCount.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::Stats::Stats()
+	: jobs(0)
+	, steals(0)
+{
+}
+
+JobSystem::JobSystem()
+	: mQueues()
+	, mWorkers()
+	, mQueued(0)
+	, mJobs(0)
+	, mSteals(0)
+	, mSleepMutex()
+	, mSleepCondition()
+	, mStop(false)
+{
+	mQueues.emplace_back(new Queue());
+}
+
+JobSystem::~JobSystem()
+{
+	stop();
+}
+
+void JobSystem::start(U32 threads)
+{
+	if (!mWorkers.empty())
+	{
+		return;
+	}
+	if (threads == 0)
+	{
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	mStop = false;
+	while (mQueues.size() < threads)
+	{
+		mQueues.emplace_back(new Queue());
+	}
+	mWorkers.reserve(threads - 1);
+	for (U32 i = 1; i < threads; i++)
+	{
+		mWorkers.emplace_back(&JobSystem::work, this, i);
+	}
+}
+
+void JobSystem::stop()
+{
+	if (mWorkers.empty())
+	{
+		return;
+	}
+	mSleepMutex.lock();
+	mStop = true;
+	mSleepMutex.unlock();
+	mSleepCondition.notify_all();
+	for (Thread& worker : mWorkers)
+	{
+		worker.wait();
+	}
+	mWorkers.clear();
+
+	// Jobs left behind are run by the caller
+	Entry entry;
+	while (pop(0, entry))
+	{
+		entry.job();
+		mJobs++;
+		entry.counter->mCount.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+U32 JobSystem::getThreadCount() const
+{
+	return mWorkers.size() + 1;
+}
+
+void JobSystem::run(Counter& counter, Job job)
+{
+	counter.mCount.fetch_add(1, std::memory_order_relaxed);
+	if (mWorkers.empty())
+	{
+		job();
+		mJobs++;
+		counter.mCount.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	Queue& queue = *mQueues[getThisIndex()];
+	mQueued++;
+	queue.mutex.lock();
+	queue.entries.push_back({ std::move(job), &counter });
+	queue.mutex.unlock();
+
+	// A worker going to sleep checks mQueued under this mutex : it can't miss the notification
+	mSleepMutex.lock();
+	mSleepMutex.unlock();
+	mSleepCondition.notify_one();
+}
+
+void JobSystem::wait(Counter& counter)
+{
+	const U32 index = getThisIndex();
+	while (!counter.isDone())
+	{
+		if (!execute(index))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+JobSystem::Stats JobSystem::getStats() const
+{
+	Stats stats;
+	stats.jobs = mJobs.load();
+	stats.steals = mSteals.load();
+	return stats;
+}
+
+void JobSystem::work(U32 index)
+{
+	sThisIndex = index;
+	while (true)
+	{
+		if (execute(index))
+		{
+			continue;
+		}
+		mSleepMutex.lock();
+		mSleepCondition.wait(mSleepMutex, [this]() { return mStop || mQueued.load() > 0; });
+		const bool stop = mStop;
+		mSleepMutex.unlock();
+		if (stop)
+		{
+			break;
+		}
+	}
+}
+
+bool JobSystem::execute(U32 index)
+{
+	Entry entry;
+	if (!pop(index, entry))
+	{
+		return false;
+	}
+	entry.job();
+	mJobs++;
+	entry.counter->mCount.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+bool JobSystem::pop(U32 index, Entry& entry)
+{
+	// Newest job of its own queue : its data is probably still in the cache
+	Queue& own = *mQueues[index];
+	own.mutex.lock();
+	if (!own.entries.empty())
+	{
+		entry = std::move(own.entries.back());
+		own.entries.pop_back();
+		own.mutex.unlock();
+		mQueued--;
+		return true;
+	}
+	own.mutex.unlock();
+
+	// Oldest job of another queue
+	const U32 count = mQueues.size();
+	for (U32 i = 1; i < count; i++)
+	{
+		Queue& other = *mQueues[(index + i) % count];
+		other.mutex.lock();
+		if (!other.entries.empty())
+		{
+			entry = std::move(other.entries.front());
+			other.entries.pop_front();
+			other.mutex.unlock();
+			mQueued--;
+			mSteals++;
+			return true;
+		}
+		other.mutex.unlock();
+	}
+	return false;
+}
+
+U32 JobSystem::getThisIndex()
+{
+	return sThisIndex;
+}
+
+} // namespace oe
@@ -0,0 +1,117 @@
+#ifndef OE_JOBSYSTEM_HPP
+#define OE_JOBSYSTEM_HPP
+
+#include "Prerequisites.hpp"
+#include "NonCopyable.hpp"
+#include "Thread.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace oe
+{
+
+// Jobs run by a pool of workers, each with its own deque
+// A thread takes the newest job of its own deque, or steals the oldest job of another deque
+// The thread that waits for a counter runs jobs until the counter is done
+// With one thread, every job runs immediately on the caller in submission order : the result is deterministic
+class JobSystem : private NonCopyable
+{
+	public:
+		using Job = std::function<void()>;
+
+		// Number of jobs not finished yet
+		class Counter
+		{
+			public:
+				Counter();
+
+				bool isDone() const;
+
+			private:
+				friend class JobSystem;
+				std::atomic<U32> mCount;
+		};
+
+		struct Stats
+		{
+			Stats();
+
+			U64 jobs;
+			U64 steals;
+		};
+
+		JobSystem();
+		~JobSystem();
+
+		// Threads including the caller, 0 : one per core
+		void start(U32 threads = 0);
+		void stop();
+		U32 getThreadCount() const;
+
+		// The job can be run by any thread, and can run and wait for other jobs
+		void run(Counter& counter, Job job);
+		void wait(Counter& counter);
+
+		// function(begin, end) on slices of at most grain items, returns when every slice is done
+		template <typename F>
+		void parallelFor(U32 count, U32 grain, F function);
+
+		Stats getStats() const;
+
+	private:
+		struct Entry
+		{
+			Job job;
+			Counter* counter;
+		};
+
+		struct Queue
+		{
+			Mutex mutex;
+			std::deque<Entry> entries;
+		};
+
+		void work(U32 index);
+		bool execute(U32 index);
+		bool pop(U32 index, Entry& entry);
+
+		static U32 getThisIndex();
+
+	private:
+		std::vector<std::unique_ptr<Queue>> mQueues; // 0 : caller
+		std::vector<Thread> mWorkers;
+		std::atomic<U32> mQueued;
+		std::atomic<U64> mJobs;
+		std::atomic<U64> mSteals;
+		Mutex mSleepMutex;
+		std::condition_variable_any mSleepCondition;
+		bool mStop;
+};
+
+template <typename F>
+void JobSystem::parallelFor(U32 count, U32 grain, F function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	if (grain == 0)
+	{
+		grain = 1;
+	}
+	Counter counter;
+	for (U32 begin = 0; begin < count; begin += grain)
+	{
+		const U32 end = (count - begin > grain) ? begin + grain : count;
+		run(counter, [&function, begin, end]() { function(begin, end); });
+	}
+	wait(counter);
+}
+
+} // namespace oe
+
+#endif // OE_JOBSYSTEM_HPP
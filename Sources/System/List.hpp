@@ -3,12 +3,16 @@
 
 #include "../System/Prerequisites.hpp"
 
+#include <unordered_map>
 #include <vector>
 
 namespace oe
 {
 
-template <typename T>
+// Vector with an index of the positions : insert, remove and has are O(1)
+// remove moves the last item in the hole, the order is only kept by removeIf
+// If the order is changed through the iterators (sort), reindex() must be called
+template <typename T, typename Hash = std::hash<T>>
 class List
 {
 	public:
@@ -17,25 +21,22 @@ class List
 		using reverse_iterator = typename std::vector<T>::reverse_iterator;
 		using const_reverse_iterator = typename std::vector<T>::const_reverse_iterator;
 
-		List() : mList() {}
+		List() : mList(), mIndices() {}
 
-		void clear() { mList.clear(); }
+		void clear()
+		{
+			mList.clear();
+			mIndices.clear();
+		}
 
-		bool has(T item)
+		bool has(const T& item) const
 		{
-			for (T i : mList)
-			{
-				if (i == item)
-				{
-					return true;
-				}
-			}
-			return false;
+			return mIndices.find(item) != mIndices.end();
 		}
 
-		bool insert(T item)
+		bool insert(const T& item)
 		{
-			if (!has(item))
+			if (mIndices.emplace(item, static_cast<U32>(mList.size())).second)
 			{
 				mList.push_back(item);
 				return true;
@@ -43,32 +44,72 @@ class List
 			return false;
 		}
 
-		bool remove(T item)
+		bool remove(const T& item)
 		{
-			for (auto itr = mList.begin(); itr != mList.end(); ++itr)
+			auto itr = mIndices.find(item);
+			if (itr == mIndices.end())
 			{
-				if (item == *itr)
+				return false;
+			}
+			const U32 index = itr->second;
+			mIndices.erase(itr);
+			if (index + 1 < mList.size())
+			{
+				mList[index] = mList.back();
+				mIndices[mList[index]] = index;
+			}
+			mList.pop_back();
+			return true;
+		}
+
+		// Remove every item matching the predicate, the others keep their order
+		template <typename F>
+		U32 removeIf(F predicate)
+		{
+			U32 kept = 0;
+			const U32 count = mList.size();
+			for (U32 i = 0; i < count; i++)
+			{
+				if (predicate(mList[i]))
 				{
-					mList.erase(itr);
-					return true;
+					mIndices.erase(mList[i]);
+				}
+				else
+				{
+					if (kept != i)
+					{
+						mList[kept] = mList[i];
+						mIndices[mList[kept]] = kept;
+					}
+					kept++;
 				}
 			}
-			return false;
+			mList.resize(kept);
+			return count - kept;
 		}
 
-		U32 size() const { return mList.size(); }
-		bool empty() const { return mList.empty(); }
+		void reserve(U32 capacity)
+		{
+			mList.reserve(capacity);
+			mIndices.reserve(capacity);
+		}
 
-		iterator find(T item)
+		void reindex()
 		{
-			for (auto itr = begin(); itr != end(); ++itr)
+			const U32 count = mList.size();
+			for (U32 i = 0; i < count; i++)
 			{
-				if (item == *itr)
-				{
-					return itr;
-				}
+				mIndices[mList[i]] = i;
 			}
-			return end();
+		}
+
+		U32 size() const { return mList.size(); }
+		bool empty() const { return mList.empty(); }
+
+		iterator find(const T& item)
+		{
+			auto itr = mIndices.find(item);
+			return (itr != mIndices.end()) ? begin() + itr->second : end();
 		}
 
 		iterator begin()
@@ -133,6 +174,7 @@ class List
 
 	protected:
 		std::vector<T> mList;
+		std::unordered_map<T, U32, Hash> mIndices;
 };
 
 } // namespace oe
@@ -3,6 +3,22 @@
 namespace oe
 {
 
+constexpr U32 MapUtility::HexNeighborCount;
+constexpr I32 MapUtility::HexOffsets[2][2][MapUtility::HexNeighborCount][2];
+
+bool MapUtility::areHexNeighbors(const Vector2i& a, const Vector2i& b, StaggerIndex staggerIndex, StaggerAxis staggerAxis)
+{
+	const I32 (&offsets)[HexNeighborCount][2] = HexOffsets[staggerAxis][getHexParity(a, staggerIndex, staggerAxis)];
+	for (U32 i = 0; i < HexNeighborCount; i++)
+	{
+		if (a.x + offsets[i][0] == b.x && a.y + offsets[i][1] == b.y)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 std::vector<Vector2i> MapUtility::getNeighboors(const Vector2i& coords, Orientation orientation, bool diag, StaggerIndex staggerIndex, StaggerAxis staggerAxis)
 {
 	// TODO : Use emplace_back
@@ -61,48 +77,8 @@ std::vector<Vector2i> MapUtility::getNeighboors(const Vector2i& coords, Orientat
 	}
 	else if (orientation == Orientation::Hexagonal)
 	{
-		if (staggerAxis == StaggerAxis::Y) // Pointy
-		{
-			if (coords.y % 2 == (I32)staggerIndex)
-			{
-				n.push_back({ coords.x - 1, coords.y - 1 });
-				n.push_back({ coords.x, coords.y - 1 });
-				n.push_back({ coords.x + 1, coords.y });
-				n.push_back({ coords.x, coords.y + 1 });
-				n.push_back({ coords.x - 1, coords.y + 1 });
-				n.push_back({ coords.x - 1, coords.y });
-			}
-			else
-			{
-				n.push_back({ coords.x, coords.y - 1 });
-				n.push_back({ coords.x + 1, coords.y - 1 });
-				n.push_back({ coords.x + 1, coords.y });
-				n.push_back({ coords.x + 1, coords.y + 1 });
-				n.push_back({ coords.x, coords.y + 1 });
-				n.push_back({ coords.x - 1, coords.y });
-			}
-		}
-		else // Flat
-		{
-			if (coords.x % 2 == (I32)staggerIndex)
-			{
-				n.push_back({ coords.x - 1, coords.y - 1 });
-				n.push_back({ coords.x, coords.y - 1 });
-				n.push_back({ coords.x + 1, coords.y - 1 });
-				n.push_back({ coords.x + 1, coords.y });
-				n.push_back({ coords.x, coords.y + 1 });
-				n.push_back({ coords.x - 1, coords.y });
-			}
-			else
-			{
-				n.push_back({ coords.x - 1, coords.y });
-				n.push_back({ coords.x, coords.y - 1 });
-				n.push_back({ coords.x + 1, coords.y });
-				n.push_back({ coords.x + 1, coords.y + 1 });
-				n.push_back({ coords.x, coords.y + 1 });
-				n.push_back({ coords.x - 1, coords.y + 1 });
-			}
-		}
+		n.reserve(HexNeighborCount);
+		getNeighboors(n, coords, orientation, diag, staggerIndex, staggerAxis);
 	}
 	return n;
 }
@@ -163,47 +139,10 @@ void MapUtility::getNeighboors(std::vector<Vector2i>& neighbors, const Vector2i&
 	}
 	else if (orientation == Orientation::Hexagonal)
 	{
-		if (staggerAxis == StaggerAxis::Y) // Pointy
+		const I32 (&offsets)[HexNeighborCount][2] = HexOffsets[staggerAxis][getHexParity(coords, staggerIndex, staggerAxis)];
+		for (U32 i = 0; i < HexNeighborCount; i++)
 		{
-			if (coords.y % 2 == (I32)staggerIndex)
-			{
-				neighbors.emplace_back(coords.x - 1, coords.y - 1);
-				neighbors.emplace_back(coords.x, coords.y - 1);
-				neighbors.emplace_back(coords.x + 1, coords.y);
-				neighbors.emplace_back(coords.x, coords.y + 1);
-				neighbors.emplace_back(coords.x - 1, coords.y + 1);
-				neighbors.emplace_back(coords.x - 1, coords.y);
-			}
-			else
-			{
-				neighbors.emplace_back(coords.x, coords.y - 1);
-				neighbors.emplace_back(coords.x + 1, coords.y - 1);
-				neighbors.emplace_back(coords.x + 1, coords.y);
-				neighbors.emplace_back(coords.x + 1, coords.y + 1);
-				neighbors.emplace_back(coords.x, coords.y + 1);
-				neighbors.emplace_back(coords.x - 1, coords.y);
-			}
-		}
-		else // Flat
-		{
-			if (coords.x % 2 == (I32)staggerIndex)
-			{
-				neighbors.emplace_back(coords.x - 1, coords.y - 1);
-				neighbors.emplace_back(coords.x, coords.y - 1);
-				neighbors.emplace_back(coords.x + 1, coords.y - 1);
-				neighbors.emplace_back(coords.x + 1, coords.y);
-				neighbors.emplace_back(coords.x, coords.y + 1);
-				neighbors.emplace_back(coords.x - 1, coords.y);
-			}
-			else
-			{
-				neighbors.emplace_back(coords.x - 1, coords.y);
-				neighbors.emplace_back(coords.x, coords.y - 1);
-				neighbors.emplace_back(coords.x + 1, coords.y);
-				neighbors.emplace_back(coords.x + 1, coords.y + 1);
-				neighbors.emplace_back(coords.x, coords.y + 1);
-				neighbors.emplace_back(coords.x - 1, coords.y + 1);
-			}
+			neighbors.emplace_back(coords.x + offsets[i][0], coords.y + offsets[i][1]);
 		}
 	}
 }
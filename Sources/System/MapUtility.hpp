@@ -33,10 +33,80 @@ class MapUtility
 
 		static std::vector<Vector2i> getNeighboors(const Vector2i& coords, Orientation orientation, bool diag = false, StaggerIndex staggerIndex = StaggerIndex::Odd, StaggerAxis staggerAxis = StaggerAxis::Y);
 		static void getNeighboors(std::vector<Vector2i>& neighbors, const Vector2i& coords, Orientation orientation, bool diag = false, StaggerIndex staggerIndex = StaggerIndex::Odd, StaggerAxis staggerAxis = StaggerAxis::Y);
+
+		// Hexagonal neighbors without allocation, in the same order as getNeighboors
+		// Offsets by stagger axis, then by parity (0 : the row/column matches the stagger index)
+		static constexpr U32 HexNeighborCount = 6;
+		static constexpr I32 HexOffsets[2][2][HexNeighborCount][2] =
+		{
+			{ // X : Flat
+				{ { -1, -1 }, { 0, -1 }, { 1, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } },
+				{ { -1, 0 }, { 0, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 } }
+			},
+			{ // Y : Pointy
+				{ { -1, -1 }, { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 1 }, { -1, 0 } },
+				{ { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 0 } }
+			}
+		};
+
+		// Range over the offsets table : nothing is stored but the center
+		class HexNeighbors
+		{
+			public:
+				class Iterator
+				{
+					public:
+						Iterator(const HexNeighbors& neighbors, U32 index) : mNeighbors(neighbors), mIndex(index) {}
+						Vector2i operator*() const { return mNeighbors[mIndex]; }
+						Iterator& operator++() { mIndex++; return *this; }
+						bool operator!=(const Iterator& other) const { return mIndex != other.mIndex; }
+
+					private:
+						const HexNeighbors& mNeighbors;
+						U32 mIndex;
+				};
+
+				HexNeighbors(const Vector2i& coords, StaggerIndex staggerIndex = StaggerIndex::Odd, StaggerAxis staggerAxis = StaggerAxis::Y)
+					: mX(coords.x), mY(coords.y), mOffsets(HexOffsets[staggerAxis][getHexParity(coords, staggerIndex, staggerAxis)]) {}
+
+				Iterator begin() const { return Iterator(*this, 0); }
+				Iterator end() const { return Iterator(*this, HexNeighborCount); }
+				U32 size() const { return HexNeighborCount; }
+				Vector2i operator[](U32 index) const { return Vector2i(mX + mOffsets[index][0], mY + mOffsets[index][1]); }
+
+			private:
+				I32 mX;
+				I32 mY;
+				const I32 (*mOffsets)[2];
+		};
+
+		// The stagger is known at compile time : only the parity is tested
+		template <StaggerIndex I = StaggerIndex::Odd, StaggerAxis A = StaggerAxis::Y, typename F>
+		static void forEachHexNeighbor(const Vector2i& coords, F&& function);
+
+		static bool areHexNeighbors(const Vector2i& a, const Vector2i& b, StaggerIndex staggerIndex = StaggerIndex::Odd, StaggerAxis staggerAxis = StaggerAxis::Y);
+
 		static Vector2i worldToCoords(const Vector2& world, Orientation orientation, const Vector2i& tileSize, StaggerIndex staggerIndex = StaggerIndex::Odd, StaggerAxis staggerAxis = StaggerAxis::Y, U32 hexSide = 0);
 		static Vector2 coordsToWorld(const Vector2i& coords, Orientation orientation, const Vector2i& tileSize, StaggerIndex staggerIndex = StaggerIndex::Odd, StaggerAxis staggerAxis = StaggerAxis::Y, U32 hexSide = 0);
+
+	private:
+		static U32 getHexParity(const Vector2i& coords, StaggerIndex staggerIndex, StaggerAxis staggerAxis)
+		{
+			const I32 c = (staggerAxis == StaggerAxis::Y) ? coords.y : coords.x;
+			return (c % 2 == (I32)staggerIndex) ? 0 : 1;
+		}
 };
 
+template <MapUtility::StaggerIndex I, MapUtility::StaggerAxis A, typename F>
+void MapUtility::forEachHexNeighbor(const Vector2i& coords, F&& function)
+{
+	const I32 (&offsets)[HexNeighborCount][2] = HexOffsets[A][getHexParity(coords, I, A)];
+	for (U32 i = 0; i < HexNeighborCount; i++)
+	{
+		function(Vector2i(coords.x + offsets[i][0], coords.y + offsets[i][1]));
+	}
+}
+
 } // namespace oe
 
 #endif // OE_MAPUTILITY_HPP
\ No newline at end of file
@@ -7,6 +7,8 @@ Node::Node()
 	: mParent(nullptr)
 	, mChilds()
 	, mLocalPosition(0.0f, 0.0f, 0.0f)
+	, mPreviousPosition(0.0f, 0.0f)
+	, mSimulatedPosition(0.0f, 0.0f)
 	, mLocalScale(1.0f, 1.0f)
 	, mLocalRotation(0.0f)
 	, mLocalTransform()
@@ -248,6 +250,42 @@ void Node::ensureUpdateGlobalZ() const
 	}
 }
 
+void Node::savePreviousPosition()
+{
+	mPreviousPosition.x = mLocalPosition.x;
+	mPreviousPosition.y = mLocalPosition.y;
+}
+
+const Vector2& Node::getPreviousPosition() const
+{
+	return mPreviousPosition;
+}
+
+bool Node::beginInterpolation(F32 alpha)
+{
+	// Exact comparison : a node that did not move is not touched
+	if (mPreviousPosition.x == mLocalPosition.x && mPreviousPosition.y == mLocalPosition.y)
+	{
+		return false;
+	}
+	mSimulatedPosition.x = mLocalPosition.x;
+	mSimulatedPosition.y = mLocalPosition.y;
+	const Vector2 position(Vector2::lerp(mPreviousPosition, mSimulatedPosition, alpha));
+	mLocalPosition.x = position.x;
+	mLocalPosition.y = position.y;
+	mLocalTransformUpdated = false;
+	invalidateNode();
+	return true;
+}
+
+void Node::endInterpolation()
+{
+	mLocalPosition.x = mSimulatedPosition.x;
+	mLocalPosition.y = mSimulatedPosition.y;
+	mLocalTransformUpdated = false;
+	invalidateNode();
+}
+
 void Node::addChild(Node* node)
 {
 	#ifdef OE_SAFETY
@@ -49,6 +49,13 @@ class Node
 		void ensureUpdateGlobalTransform() const;
 		void ensureUpdateGlobalZ() const;
 
+		// Render interpolation : the node is drawn between the position saved at the start of the last simulation step and the current one
+		// endInterpolation restores the exact simulated position, so the simulation never sees the interpolated one
+		void savePreviousPosition();
+		const Vector2& getPreviousPosition() const;
+		bool beginInterpolation(F32 alpha);
+		void endInterpolation();
+
 		// TODO : Convert position in Local/Global space
 
 		OeSignal(onNodeInvalidation, const Node*);
@@ -69,6 +76,8 @@ class Node
 		std::vector<Node*> mChilds;
 
 		Vector3 mLocalPosition;
+		Vector2 mPreviousPosition;
+		Vector2 mSimulatedPosition;
 		Vector2 mLocalScale;
 		F32 mLocalRotation;
 		mutable sf::Transform mLocalTransform;
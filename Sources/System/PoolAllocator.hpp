@@ -4,18 +4,44 @@
 #include "Prerequisites.hpp"
 #include "NonCopyable.hpp"
 
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
 namespace oe
 {
 
-/*
-
+// Small object allocator : blocks are taken from chunks of chunkSize bytes, one free list per block size
+// Objects of the same size class share their blocks, freed blocks are reused first and chunks are only released by clear()
+// Bigger objects than MaxBlockSize use malloc
 template <U32 chunkSize>
 class PoolAllocator : private NonCopyable
 {
 	public:
+		struct Stats
+		{
+			Stats()
+				: live(0)
+				, peak(0)
+				, chunks(0)
+				, large(0)
+			{
+			}
+
+			U32 live; // Allocated blocks
+			U32 peak; // High-water mark of live
+			U32 chunks;
+			U32 large; // Live allocations bigger than MaxBlockSize
+		};
+
+		static const U32 MaxBlockSize = 2048;
+
 		PoolAllocator()
 		{
 			ASSERT(BlockSizes < UCHAR_MAX);
+			ASSERT(chunkSize >= MaxBlockSize);
 			mChunkSpace = ChunkArrayIncrement;
 			mChunkCount = 0;
 			mChunks = (Chunk*)std::malloc(mChunkSpace * sizeof(Chunk));
@@ -52,23 +78,27 @@ class PoolAllocator : private NonCopyable
 			std::free(mChunks);
 		}
 
-		/// Allocate memory. This will use alloc if the size is larger than MaxBlockSize.
-		template <typename T, typename ... Args>
-		T* alloc(Args&& ... args)
+		/// Allocate memory. This will use malloc if the size is larger than MaxBlockSize.
+		void* alloc(U32 size)
 		{
-			const U32 size = sizeof(T);
 			ASSERT(size > 0);
 			if (size > MaxBlockSize)
 			{
-				return new (oe::alloc(size)) T(std::forward<Args>(args)...);
+				mStats.large++;
+				return std::malloc(size);
 			}
 			U32 index = mBlockSizeLookup[size];
 			ASSERT(index < BlockSizes);
+			mStats.live++;
+			if (mStats.live > mStats.peak)
+			{
+				mStats.peak = mStats.live;
+			}
 			if (mFreeLists[index] != nullptr)
 			{
 				Block* block = mFreeLists[index];
 				mFreeLists[index] = block->next;
-				return new (block) T(std::forward<Args>(args)...);
+				return block;
 			}
 			else
 			{
@@ -76,15 +106,15 @@ class PoolAllocator : private NonCopyable
 				{
 					Chunk* oldChunks = mChunks;
 					mChunkSpace += ChunkArrayIncrement;
-					mChunks = (Chunk*)oe::alloc(mChunkSpace * sizeof(Chunk));
-					memcpy(mChunks, oldChunks, mChunkCount * sizeof(Chunk));
-					memset(mChunks + mChunkCount, 0, ChunkArrayIncrement * sizeof(Chunk));
-					::free(oldChunks);
+					mChunks = (Chunk*)std::malloc(mChunkSpace * sizeof(Chunk));
+					std::memcpy(mChunks, oldChunks, mChunkCount * sizeof(Chunk));
+					std::memset(mChunks + mChunkCount, 0, ChunkArrayIncrement * sizeof(Chunk));
+					std::free(oldChunks);
 				}
 				Chunk* chunk = mChunks + mChunkCount;
-				chunk->blocks = (Block*)oe::alloc(chunkSize);
+				chunk->blocks = (Block*)std::malloc(chunkSize);
 				#if defined(OE_DEBUG)
-					memset(chunk->blocks, 0xcd, chunkSize);
+					std::memset(chunk->blocks, 0xcd, chunkSize);
 				#endif
 				U32 blockSize = mBlockSizes[index];
 				chunk->blockSize = blockSize;
@@ -99,19 +129,24 @@ class PoolAllocator : private NonCopyable
 				last->next = nullptr;
 				mFreeLists[index] = chunk->blocks->next;
 				mChunkCount++;
-				return new (chunk->blocks) T(std::forward<Args>(args)...);
+				mStats.chunks = mChunkCount;
+				return chunk->blocks;
 			}
 		}
 
-		/// Free memory. This will use free if the size is larger than MaxBlockSize.
-		template <typename T>
-		void free(void* p)
+		/// Free memory. The size must be the one given to alloc.
+		void free(void* p, U32 size)
 		{
-			const U32 size = sizeof(T);
 			ASSERT(size > 0);
+			if (p == nullptr)
+			{
+				return;
+			}
 			if (size > MaxBlockSize)
 			{
-				::free(p);
+				ASSERT(mStats.large > 0);
+				mStats.large--;
+				std::free(p);
 				return;
 			}
 			U32 index = mBlockSizeLookup[size];
@@ -136,22 +171,48 @@ class PoolAllocator : private NonCopyable
 					}
 				}
 				ASSERT(found);
-				memset(p, 0xfd, blockSize);
+				std::memset(p, 0xfd, blockSize);
 			#endif
+			ASSERT(mStats.live > 0);
+			mStats.live--;
 			Block* block = (Block*)p;
 			block->next = mFreeLists[index];
 			mFreeLists[index] = block;
 		}
 
+		template <typename T, typename ... Args>
+		T* create(Args&& ... args)
+		{
+			return new (alloc(sizeof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template <typename T>
+		void destroy(T* p)
+		{
+			if (p != nullptr)
+			{
+				p->~T();
+				free(p, sizeof(T));
+			}
+		}
+
+		// Every block is released : the objects must have been destroyed
 		void clear()
 		{
 			for (U32 i = 0; i < mChunkCount; i++)
 			{
-				::free(mChunks[i].blocks);
+				std::free(mChunks[i].blocks);
 			}
 			mChunkCount = 0;
 			std::memset(mChunks, 0, mChunkSpace * sizeof(Chunk));
 			std::memset(mFreeLists, 0, sizeof(mFreeLists));
+			mStats.live = 0;
+			mStats.chunks = 0;
+		}
+
+		const Stats& getStats() const
+		{
+			return mStats;
 		}
 
 	private:
@@ -166,8 +227,7 @@ class PoolAllocator : private NonCopyable
 			Block* blocks;
 		};
 
-		static const U32 MaxBlockSize = 640;
-		static const U32 BlockSizes = 14;
+		static const U32 BlockSizes = 18;
 		static const U32 ChunkArrayIncrement = 128;
 		static U32 mBlockSizes[BlockSizes];
 		static U8 mBlockSizeLookup[MaxBlockSize + 1];
@@ -178,8 +238,13 @@ class PoolAllocator : private NonCopyable
 		U32 mChunkSpace;
 
 		Block* mFreeLists[BlockSizes];
+
+		Stats mStats;
 };
 
+template <U32 chunkSize>
+const U32 PoolAllocator<chunkSize>::MaxBlockSize;
+
 template <U32 chunkSize>
 U32 PoolAllocator<chunkSize>::mBlockSizes[BlockSizes] =
 {
@@ -197,6 +262,10 @@ U32 PoolAllocator<chunkSize>::mBlockSizes[BlockSizes] =
 	448,	// 11
 	512,	// 12
 	640,	// 13
+	768,	// 14
+	1024,	// 15
+	1536,	// 16
+	2048,	// 17
 };
 
 template <U32 chunkSize>
@@ -204,8 +273,6 @@ U8 PoolAllocator<chunkSize>::mBlockSizeLookup[MaxBlockSize + 1];
 
 using DefaultPoolAllocator = PoolAllocator<16 * 1024>;
 
-*/
-
 } // namespace oe
 
 #endif // OE_POOLALLOCATOR_HPP
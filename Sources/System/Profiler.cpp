@@ -64,6 +64,38 @@ void Profiler::endProfile(const std::string& profileName)
 	profile.mCalls++;
 }
 
+void Profiler::setCounter(const std::string& counterName, U32 value)
+{
+	ASSERT(!counterName.empty());
+
+	U32 index = 0;
+	bool found = false;
+	for (U32 i = 0; i < mCounters.size(); i++)
+	{
+		if (mCounters[i].mName == counterName)
+		{
+			found = true;
+			index = i;
+			break;
+		}
+	}
+	if (!found)
+	{
+		mCounters.emplace_back(counterName);
+		index = mCounters.size() - 1;
+	}
+	CounterInstance& counter = mCounters[index];
+	counter.mValue = value;
+	if (value < counter.mMin)
+	{
+		counter.mMin = value;
+	}
+	if (value > counter.mMax)
+	{
+		counter.mMax = value;
+	}
+}
+
 void Profiler::display()
 {
 	printf("----------------------------------------\n");
@@ -71,6 +103,10 @@ void Profiler::display()
 	{
 		mProfiles[i].display();
 	}
+	for (U32 i = 0; i < mCounters.size(); i++)
+	{
+		mCounters[i].display();
+	}
 	printf("----------------------------------------\n");
 }
 
@@ -110,4 +146,17 @@ void Profiler::ProfileInstance::display()
 	printf("[%s] c:%u -:%d +:%d ~:%u\n", mName.c_str(), mCalls, mMin.asMilliseconds(), mMax.asMilliseconds(), (mSumm.asMilliseconds()/mCalls));
 }
 
+Profiler::CounterInstance::CounterInstance(const std::string& counterName)
+	: mName(counterName)
+	, mValue(0)
+	, mMin(0xFFFFFFFF)
+	, mMax(0)
+{
+}
+
+void Profiler::CounterInstance::display()
+{
+	printf("[%s] =:%u -:%u +:%u\n", mName.c_str(), mValue, mMin, mMax);
+}
+
 } // namespace oe
\ No newline at end of file
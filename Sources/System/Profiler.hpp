@@ -13,10 +13,12 @@
 #define Profile(a) oe::Profiler::ProfileIndividual mProfile(a);
 #define ProfileBegin(a) oe::Profiler::getSingleton().beginProfile((a));
 #define ProfileEnd(a) oe::Profiler::getSingleton().endProfile((a));
+#define ProfileCounter(a, v) do { if (oe::Profiler::getSingletonPtr() != nullptr) { oe::Profiler::getSingleton().setCounter((a), (v)); } } while (0)
 #else
 #define Profile(a)
 #define ProfileBegin(a)
 #define ProfileEnd(a)
+#define ProfileCounter(a, v)
 #endif
 
 namespace oe
@@ -31,6 +33,9 @@ class Profiler : public Singleton<Profiler>
 		void beginProfile(const std::string& profileName);
 		void endProfile(const std::string& profileName);
 
+		// Value of the last frame, like a number of objects drawn
+		void setCounter(const std::string& counterName, U32 value);
+
 		void display();
 
 		static Profiler* getSingletonPtr();
@@ -62,7 +67,21 @@ class Profiler : public Singleton<Profiler>
 				Time mSumm;
 		};
 
+		class CounterInstance
+		{
+			public:
+				CounterInstance(const std::string& counterName);
+
+				void display();
+
+				std::string mName;
+				U32 mValue;
+				U32 mMin;
+				U32 mMax;
+		};
+
 		std::vector<ProfileInstance> mProfiles;
+		std::vector<CounterInstance> mCounters;
 };
 
 } // namespace oe
@@ -0,0 +1,27 @@
+#include "StackAllocator.hpp"
+
+namespace oe
+{
+
+template <> FrameAllocator* Singleton<FrameAllocator>::mSingleton = nullptr;
+
+FrameAllocator::FrameAllocator()
+{
+}
+
+FrameAllocator::~FrameAllocator()
+{
+}
+
+FrameAllocator& FrameAllocator::getSingleton()
+{
+	ASSERT(mSingleton != nullptr);
+	return *mSingleton;
+}
+
+FrameAllocator* FrameAllocator::getSingletonPtr()
+{
+	return mSingleton;
+}
+
+} // namespace oe
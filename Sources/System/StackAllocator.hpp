@@ -1,50 +1,64 @@
 #ifndef OE_STACKALLOCATOR_HPP
 #define OE_STACKALLOCATOR_HPP
 
+#include "Prerequisites.hpp"
 #include "NonCopyable.hpp"
+#include "Singleton.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
 
 namespace oe
 {
 
-/*
-
+// Linear allocator : allocations are taken one after the other in a fixed buffer, and released all at once by clear()
 template <U32 maxBytes>
 class StackAllocator : private NonCopyable
 {
 	public:
+		static const U32 DefaultAlignment = alignof(std::max_align_t);
+
 		StackAllocator()
 		{
 			mIndex = 0;
-			#ifdef OE_DEBUG
-				mMaxAllocation = 0;
-			#endif
+			mMaxAllocation = 0;
 		}
 
-		~StackAllocator()
+		// nullptr if the buffer is full
+		void* alloc(U32 bytes, U32 alignment = DefaultAlignment)
 		{
-			ASSERT(mIndex == 0);
+			ASSERT(bytes > 0);
+			ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+			const U32 start = (mIndex + alignment - 1) & ~(alignment - 1);
+			if (start + bytes > maxBytes || start + bytes < start)
+			{
+				return nullptr;
+			}
+			mIndex = start + bytes;
+			if (mIndex > mMaxAllocation)
+			{
+				mMaxAllocation = mIndex;
+			}
+			return mData + start;
 		}
 
 		template <typename T, typename ... Args>
 		T* alloc(Args&& ... args)
 		{
-			const U32 bytes = sizeof(T);
-			ASSERT(bytes > 0);
-			ASSERT(mIndex + bytes <= maxBytes);
-			U8* mem = mData + mIndex;
-			mIndex += bytes;
-			#ifdef OE_DEBUG
-				if (mIndex > mMaxAllocation)
-				{
-					mMaxAllocation = mIndex;
-				}
-			#endif
+			void* mem = alloc(sizeof(T), alignof(T));
+			ASSERT(mem != nullptr);
 			return new (mem) T(std::forward<Args>(args)...);
 		}
 
+		// Only the last allocation can be released before clear()
 		template <typename T>
-		void free(void* p)
+		void free(T* p)
 		{
+			ASSERT(reinterpret_cast<U8*>(p) + sizeof(T) == mData + mIndex);
+			p->~T();
 			mIndex -= sizeof(T);
 		}
 
@@ -53,6 +67,11 @@ class StackAllocator : private NonCopyable
 			mIndex = 0;
 		}
 
+		bool owns(const void* p) const
+		{
+			return p >= mData && p < mData + maxBytes;
+		}
+
 		U32 getSize() const
 		{
 			return mIndex;
@@ -68,61 +87,176 @@ class StackAllocator : private NonCopyable
 			return maxBytes - mIndex;
 		}
 
-		#ifdef OE_DEBUG
+		// Highest size reached since the creation
 		U32 getMaxAllocation() const
 		{
 			return mMaxAllocation;
 		}
-		#endif
 
 	private:
-		char mData[maxBytes];
+		alignas(DefaultAlignment) U8 mData[maxBytes];
 		U32 mIndex;
-
-		#ifdef OE_DEBUG
 		U32 mMaxAllocation;
-		#endif
 };
 
+// Two stacks used in turn : what is allocated during a frame is still valid during the next one
+// When a stack is full, the allocations of the frame fall back to malloc until the stack is cleared
 template <U32 maxBytes>
 class DoubleBufferAllocator : private NonCopyable
 {
 	public:
 		DoubleBufferAllocator()
 			: mIndex(0)
+			, mFrameUsage(0)
+			, mPeakUsage(0)
+			, mOverflows(0)
+		{
+			mFallbackBytes[0] = 0;
+			mFallbackBytes[1] = 0;
+		}
+
+		~DoubleBufferAllocator()
 		{
+			release(0);
+			release(1);
 		}
 
+		// Beginning of a frame : the stack of the frame before the last one is cleared
 		void swap()
 		{
+			mFrameUsage = mStacks[mIndex].getSize() + mFallbackBytes[mIndex];
+			if (mFrameUsage > mPeakUsage)
+			{
+				mPeakUsage = mFrameUsage;
+			}
 			mIndex = (U8)!mIndex;
+			clear();
 		}
 
 		void clear()
 		{
 			mStacks[mIndex].clear();
+			release(mIndex);
 		}
 
-		void* alloc(U32 bytes)
+		void* alloc(U32 bytes, U32 alignment = StackAllocator<maxBytes>::DefaultAlignment)
 		{
-			return mStacks[mIndex].alloc(bytes);
+			void* p = mStacks[mIndex].alloc(bytes, alignment);
+			if (p == nullptr)
+			{
+				p = std::malloc(bytes);
+				mFallbacks[mIndex].push_back(p);
+				mFallbackBytes[mIndex] += bytes;
+				mOverflows++;
+			}
+			return p;
 		}
 
 		template <typename T, typename ... Args>
 		T* alloc(Args&& ... args)
 		{
-			return new (alloc(sizeof(T))) T(std::forward<Args>(args)...);
+			return new (alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		// Bytes used by the last finished frame
+		U32 getFrameUsage() const
+		{
+			return mFrameUsage;
+		}
+
+		// Highest frame usage, including the fallbacks
+		U32 getPeakUsage() const
+		{
+			return mPeakUsage;
+		}
+
+		// Allocations that did not fit in the stack of their frame
+		U32 getOverflowCount() const
+		{
+			return mOverflows;
+		}
+
+		U32 getMaxSize() const
+		{
+			return maxBytes;
+		}
+
+	private:
+		void release(U8 index)
+		{
+			for (void* p : mFallbacks[index])
+			{
+				std::free(p);
+			}
+			mFallbacks[index].clear();
+			mFallbackBytes[index] = 0;
 		}
 
 	private:
 		StackAllocator<maxBytes> mStacks[2];
+		std::vector<void*> mFallbacks[2];
+		U32 mFallbackBytes[2];
 		U8 mIndex;
+		U32 mFrameUsage;
+		U32 mPeakUsage;
+		U32 mOverflows;
 };
 
 using DefaultStackAllocator = StackAllocator<100 * 1024>;
 using DefaultDoubleBufferAllocator = DoubleBufferAllocator<100 * 1024>;
 
-*/
+// Scratch memory of the frame, swapped by the Application at each iteration
+// Never keep a pointer to it for more than one frame
+class FrameAllocator : public DoubleBufferAllocator<256 * 1024>, public Singleton<FrameAllocator>
+{
+	public:
+		FrameAllocator();
+		~FrameAllocator();
+
+		static FrameAllocator& getSingleton();
+		static FrameAllocator* getSingletonPtr();
+};
+
+// STL adaptor : containers built on it are released with the frame, deallocate does nothing
+template <typename T>
+class FrameStlAllocator
+{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator()
+		{
+		}
+
+		template <typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&)
+		{
+		}
+
+		T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(FrameAllocator::getSingleton().alloc(static_cast<U32>(n * sizeof(T)), alignof(T)));
+		}
+
+		void deallocate(T*, std::size_t)
+		{
+		}
+
+		template <typename U>
+		bool operator==(const FrameStlAllocator<U>&) const
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const
+		{
+			return false;
+		}
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
 
 } // namespace oe
 
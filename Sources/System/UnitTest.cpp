@@ -3,7 +3,9 @@
 namespace oe
 {
 
-UnitTest::UnitTest(char* name)
+U32 UnitTest::mFailedChecks = 0;
+
+UnitTest::UnitTest(const char* name)
 	: mName(name)
 	, mTests()
 {
@@ -14,7 +16,7 @@ UnitTest::~UnitTest()
 {
 }
 
-void UnitTest::start(char* title)
+void UnitTest::start(const char* title)
 {
 	mTests.emplace_back(title);
 }
@@ -28,6 +30,7 @@ void UnitTest::check(bool passed, const char* expr, const char* file, int line)
 	else
 	{
 		mTests.back().failed++;
+		mFailedChecks++;
 		printf("%s : Check failed : %s (in %s line %d)\n", mTests.back().title, expr, file, line);
 	}
 }
@@ -64,7 +67,12 @@ void UnitTest::print()
 	printf("====================================\n\n\n");
 }
 
-UnitTest::Test::Test(char* pTitle)
+U32 UnitTest::getFailedChecks()
+{
+	return mFailedChecks;
+}
+
+UnitTest::Test::Test(const char* pTitle)
 	: title(pTitle)
 	, passed(0)
 	, failed(0)
@@ -18,27 +18,32 @@ namespace oe
 class UnitTest
 {
 	public:
-		UnitTest(char* name);
+		UnitTest(const char* name);
 		~UnitTest();
 
-		void start(char* title);
+		void start(const char* title);
 
 		void check(bool passed, const char* expr, const char* file, int line);
 
 		void print();
 
+		// Failed checks of every test run so far, for the exit code of a test runner
+		static U32 getFailedChecks();
+
 	private:
 		struct Test
 		{
-			Test(char* pTitle);
+			Test(const char* pTitle);
 
-			char* title;
+			const char* title;
 			U32 passed;
 			U32 failed;
 		};
 
-		char* mName;
+		const char* mName;
 		std::vector<Test> mTests;
+
+		static U32 mFailedChecks;
 };
 
 } // namespace oe
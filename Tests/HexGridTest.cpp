@@ -0,0 +1,145 @@
+#include "Tests.hpp"
+
+#include "../Sources/System/HexGrid.hpp"
+
+namespace
+{
+
+// Every cell has its own index in the storage, and the index gives the cell back
+template <oe::HexGridLayout L>
+bool roundTrip(const oe::Vector2i& size)
+{
+	oe::HexGrid<U32, L> grid(size, 0);
+	for (I32 y = 0; y < size.y; y++)
+	{
+		for (I32 x = 0; x < size.x; x++)
+		{
+			const U32 index = grid.toIndex(x, y);
+			if (index >= grid.getStorageSize() || grid[index] != 0 || grid.toCoords(index) != oe::Vector2i(x, y))
+			{
+				return false;
+			}
+			grid[index] = 1;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+BEGIN_TEST(HexGrid)
+
+TEST("Bit packing")
+{
+	// 143 cells on 3 words
+	oe::HexGrid<bool> grid(oe::Vector2i(13, 11));
+	CHECK(grid.getCellCount() == 143);
+	CHECK(grid.getStorageSize() == 143);
+	CHECK(!grid.test(0) && !grid.test(142));
+
+	// Around the word boundaries
+	grid.set(63, true);
+	grid.set(64, true);
+	CHECK(!grid.test(62) && grid.test(63) && grid.test(64) && !grid.test(65));
+	grid.set(63, false);
+	CHECK(!grid.test(63) && grid.test(64));
+	grid.set(142, true);
+	CHECK(grid.test(142) && !grid.test(141));
+
+	// Coords and indices address the same bit
+	CHECK(grid.set(oe::Vector2i(5, 7), true));
+	CHECK(grid.test(grid.toIndex(5, 7)));
+	CHECK(grid[oe::Vector2i(5, 7)] && grid[grid.toIndex(5, 7)]);
+	CHECK(!grid[oe::Vector2i(6, 7)]);
+}
+
+TEST("Test and set")
+{
+	oe::HexGrid<bool> grid(oe::Vector2i(10, 10));
+	CHECK(!grid.testAndSet(70));
+	CHECK(grid.testAndSet(70));
+	CHECK(grid.test(70) && !grid.test(69) && !grid.test(71));
+}
+
+TEST("Fill")
+{
+	oe::HexGrid<bool> grid(oe::Vector2i(13, 11), true);
+	CHECK(grid.test(0) && grid.test(64) && grid.test(142));
+	grid.fill(false);
+	bool any = false;
+	for (U32 i = 0; i < grid.getStorageSize(); i++)
+	{
+		any = any || grid.test(i);
+	}
+	CHECK(!any);
+	grid.fill(true);
+	bool all = true;
+	for (U32 i = 0; i < grid.getStorageSize(); i++)
+	{
+		all = all && grid.test(i);
+	}
+	CHECK(all);
+}
+
+TEST("Outside")
+{
+	oe::HexGrid<bool> grid(oe::Vector2i(4, 4));
+	CHECK(!grid.set(oe::Vector2i(4, 0), true));
+	CHECK(!grid.set(oe::Vector2i(-1, 2), true));
+	CHECK(grid.get(oe::Vector2i(0, 4), true));
+	CHECK(!grid.get(oe::Vector2i(0, 0), true));
+	grid.clear();
+	CHECK(grid.empty() && grid.getStorageSize() == 0);
+}
+
+TEST("Row major round trip")
+{
+	CHECK(roundTrip<oe::HexGridLayout::RowMajor>(oe::Vector2i(1, 1)));
+	CHECK(roundTrip<oe::HexGridLayout::RowMajor>(oe::Vector2i(13, 11)));
+	CHECK(roundTrip<oe::HexGridLayout::RowMajor>(oe::Vector2i(64, 3)));
+}
+
+TEST("Morton round trip")
+{
+	CHECK(roundTrip<oe::HexGridLayout::Morton>(oe::Vector2i(1, 1)));
+	CHECK(roundTrip<oe::HexGridLayout::Morton>(oe::Vector2i(8, 8)));
+	CHECK(roundTrip<oe::HexGridLayout::Morton>(oe::Vector2i(13, 11)));
+	CHECK(roundTrip<oe::HexGridLayout::Morton>(oe::Vector2i(64, 3)));
+	CHECK(roundTrip<oe::HexGridLayout::Morton>(oe::Vector2i(100, 75)));
+}
+
+TEST("Morton layout")
+{
+	// Storage is rounded up to whole 8x8 tiles
+	oe::HexGrid<U8, oe::HexGridLayout::Morton> grid(oe::Vector2i(13, 11));
+	CHECK(grid.getCellCount() == 143);
+	CHECK(grid.getStorageSize() == 4 * 64);
+
+	// Z-order inside a tile
+	CHECK(grid.toIndex(0, 0) == 0);
+	CHECK(grid.toIndex(1, 0) == 1);
+	CHECK(grid.toIndex(0, 1) == 2);
+	CHECK(grid.toIndex(1, 1) == 3);
+	CHECK(grid.toIndex(2, 0) == 4);
+	CHECK(grid.toIndex(7, 7) == 63);
+
+	// Tiles in row-major order
+	CHECK(grid.toIndex(8, 0) == 64);
+	CHECK(grid.toIndex(0, 8) == 128);
+	CHECK(grid.toIndex(12, 10) == 192 + oe::priv::HexGridIndexer<oe::HexGridLayout::Morton>::interleave(4, 2));
+}
+
+TEST("Morton bit packing")
+{
+	oe::HexGrid<bool, oe::HexGridLayout::Morton> grid(oe::Vector2i(13, 11));
+	CHECK(grid.getStorageSize() == 4 * 64);
+	CHECK(grid.set(oe::Vector2i(12, 10), true));
+	CHECK(grid.get(oe::Vector2i(12, 10), false));
+	CHECK(grid.test(grid.toIndex(12, 10)));
+	CHECK(grid.toCoords(grid.toIndex(12, 10)) == oe::Vector2i(12, 10));
+	CHECK(!grid.get(oe::Vector2i(11, 10), false) && !grid.get(oe::Vector2i(12, 9), false));
+	CHECK(!grid.testAndSet(grid.toIndex(0, 8)));
+	CHECK(grid.get(oe::Vector2i(0, 8), false));
+}
+
+END_TEST
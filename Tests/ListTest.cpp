@@ -0,0 +1,103 @@
+#include "Tests.hpp"
+
+#include "../Sources/System/List.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+// Every item is found at its position
+bool isIndexed(oe::List<U32>& list)
+{
+	for (auto itr = list.begin(); itr != list.end(); ++itr)
+	{
+		if (list.find(*itr) != itr)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+BEGIN_TEST(List)
+
+TEST("Insert")
+{
+	oe::List<U32> list;
+	CHECK(list.empty());
+	CHECK(list.insert(1));
+	CHECK(list.insert(2));
+	CHECK(!list.insert(1));
+	CHECK(list.size() == 2);
+	CHECK(list.has(1) && list.has(2) && !list.has(3));
+	CHECK(list.find(3) == list.end());
+	CHECK(isIndexed(list));
+}
+
+TEST("Swap and pop remove")
+{
+	oe::List<U32> list;
+	for (U32 i = 0; i < 5; i++)
+	{
+		list.insert(i);
+	}
+
+	// The last item takes the hole
+	CHECK(list.remove(1));
+	CHECK(!list.remove(1));
+	CHECK(list.size() == 4);
+	CHECK(*(list.begin() + 1) == 4);
+	CHECK(!list.has(1));
+	CHECK(isIndexed(list));
+
+	// Removing the last item moves nothing
+	CHECK(list.remove(3));
+	CHECK(*(list.end() - 1) == 2);
+	CHECK(isIndexed(list));
+
+	CHECK(list.remove(0) && list.remove(4) && list.remove(2));
+	CHECK(list.empty());
+	CHECK(list.insert(1));
+	CHECK(isIndexed(list));
+}
+
+TEST("Remove if")
+{
+	oe::List<U32> list;
+	for (U32 i = 0; i < 10; i++)
+	{
+		list.insert(i);
+	}
+	CHECK(list.removeIf([](U32 item) { return item % 3 == 0; }) == 4);
+	const U32 expected[] = { 1, 2, 4, 5, 7, 8 };
+	CHECK(list.size() == 6);
+	CHECK(std::equal(list.begin(), list.end(), expected));
+	CHECK(!list.has(0) && !list.has(3) && !list.has(9));
+	CHECK(isIndexed(list));
+	CHECK(list.removeIf([](U32 item) { return item > 100; }) == 0);
+	CHECK(list.removeIf([](U32) { return true; }) == 6);
+	CHECK(list.empty());
+}
+
+TEST("Reindex")
+{
+	oe::List<U32> list;
+	for (U32 i = 0; i < 8; i++)
+	{
+		list.insert(7 - i);
+	}
+	std::sort(list.begin(), list.end());
+	list.reindex();
+	CHECK(*list.begin() == 0);
+	CHECK(isIndexed(list));
+
+	// The index is still right for the next removes
+	CHECK(list.remove(0));
+	CHECK(*list.begin() == 7);
+	CHECK(isIndexed(list));
+}
+
+END_TEST
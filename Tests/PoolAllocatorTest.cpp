@@ -0,0 +1,165 @@
+#include "Tests.hpp"
+
+#include "../Sources/System/PoolAllocator.hpp"
+
+namespace
+{
+
+// Copy of the size classes of the allocator
+const U32 BlockSizes[] = { 16, 32, 64, 96, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 1024, 1536, 2048 };
+const U32 BlockSizeCount = sizeof(BlockSizes) / sizeof(BlockSizes[0]);
+
+struct Item
+{
+	Item(U32 pValue) : value(pValue) { count++; }
+	~Item() { count--; }
+
+	U32 value;
+	U64 padding[3];
+
+	static I32 count;
+};
+
+I32 Item::count = 0;
+
+} // namespace
+
+BEGIN_TEST(PoolAllocator)
+
+TEST("Size classes")
+{
+	oe::DefaultPoolAllocator allocator;
+	U32 previous = 0;
+	for (U32 i = 0; i < BlockSizeCount; i++)
+	{
+		// The first allocation of a class takes a new chunk
+		void* a = allocator.alloc(BlockSizes[i]);
+		std::memset(a, 0xab, BlockSizes[i]);
+		CHECK(a != nullptr);
+		CHECK(allocator.getStats().chunks == i + 1);
+		CHECK(allocator.getStats().live == 1);
+
+		// Every size between two classes uses the bigger one : the freed block is found again
+		allocator.free(a, BlockSizes[i]);
+		void* b = allocator.alloc(previous + 1);
+		CHECK(b == a);
+		allocator.free(b, previous + 1);
+
+		// Two live blocks of a class don't overlap
+		void* c = allocator.alloc(BlockSizes[i]);
+		void* d = allocator.alloc(BlockSizes[i]);
+		CHECK(c != d);
+		CHECK((U8*)c + BlockSizes[i] <= (U8*)d || (U8*)d + BlockSizes[i] <= (U8*)c);
+		allocator.free(c, BlockSizes[i]);
+		allocator.free(d, BlockSizes[i]);
+		CHECK(allocator.getStats().live == 0);
+		CHECK(allocator.getStats().chunks == i + 1);
+
+		previous = BlockSizes[i];
+	}
+}
+
+TEST("Reuse of freed blocks")
+{
+	oe::DefaultPoolAllocator allocator;
+	void* a = allocator.alloc(64);
+	void* b = allocator.alloc(64);
+	void* c = allocator.alloc(64);
+	allocator.free(b, 64);
+	CHECK(allocator.alloc(64) == b);
+	allocator.free(a, 64);
+	allocator.free(c, 64);
+	CHECK(allocator.alloc(60) == c);
+	CHECK(allocator.alloc(50) == a);
+	CHECK(allocator.getStats().chunks == 1);
+
+	// Another class never gets the blocks of this one
+	void* e = allocator.alloc(128);
+	CHECK(e != a && e != b && e != c);
+	CHECK(allocator.getStats().chunks == 2);
+}
+
+TEST("Large allocations")
+{
+	oe::DefaultPoolAllocator allocator;
+	void* a = allocator.alloc(oe::DefaultPoolAllocator::MaxBlockSize + 1);
+	std::memset(a, 0, oe::DefaultPoolAllocator::MaxBlockSize + 1);
+	void* b = allocator.alloc(64 * 1024);
+	CHECK(a != nullptr && b != nullptr);
+	CHECK(allocator.getStats().large == 2);
+	CHECK(allocator.getStats().live == 0);
+	CHECK(allocator.getStats().chunks == 0);
+	allocator.free(a, oe::DefaultPoolAllocator::MaxBlockSize + 1);
+	CHECK(allocator.getStats().large == 1);
+	allocator.free(b, 64 * 1024);
+	CHECK(allocator.getStats().large == 0);
+
+	// MaxBlockSize itself still comes from a chunk
+	void* c = allocator.alloc(oe::DefaultPoolAllocator::MaxBlockSize);
+	CHECK(allocator.getStats().large == 0);
+	CHECK(allocator.getStats().live == 1);
+	CHECK(allocator.getStats().chunks == 1);
+	allocator.free(c, oe::DefaultPoolAllocator::MaxBlockSize);
+}
+
+TEST("Stats")
+{
+	oe::DefaultPoolAllocator allocator;
+	std::vector<void*> blocks;
+	for (U32 i = 0; i < 10; i++)
+	{
+		blocks.push_back(allocator.alloc(32));
+	}
+	for (U32 i = 0; i < 4; i++)
+	{
+		allocator.free(blocks.back(), 32);
+		blocks.pop_back();
+	}
+	CHECK(allocator.getStats().live == 6);
+	CHECK(allocator.getStats().peak == 10);
+	CHECK(allocator.getStats().chunks == 1);
+
+	// A chunk of 16 KB holds 512 blocks of 32 bytes
+	while (blocks.size() < 512)
+	{
+		blocks.push_back(allocator.alloc(32));
+	}
+	CHECK(allocator.getStats().chunks == 1);
+	blocks.push_back(allocator.alloc(32));
+	CHECK(allocator.getStats().chunks == 2);
+	CHECK(allocator.getStats().live == 513);
+	CHECK(allocator.getStats().peak == 513);
+
+	// Freeing keeps the chunks, clear releases them and keeps the peak
+	for (void* p : blocks)
+	{
+		allocator.free(p, 32);
+	}
+	CHECK(allocator.getStats().live == 0);
+	CHECK(allocator.getStats().chunks == 2);
+	allocator.clear();
+	CHECK(allocator.getStats().chunks == 0);
+	CHECK(allocator.getStats().peak == 513);
+	allocator.alloc(32);
+	CHECK(allocator.getStats().live == 1);
+	CHECK(allocator.getStats().chunks == 1);
+}
+
+TEST("Create and destroy")
+{
+	oe::DefaultPoolAllocator allocator;
+	Item* a = allocator.create<Item>(7);
+	Item* b = allocator.create<Item>(8);
+	CHECK(Item::count == 2);
+	CHECK(a->value == 7 && b->value == 8);
+	allocator.destroy(a);
+	CHECK(Item::count == 1);
+	CHECK(allocator.create<Item>(9) == a);
+	allocator.destroy(b);
+	allocator.destroy(a);
+	allocator.destroy<Item>(nullptr);
+	CHECK(Item::count == 0);
+	CHECK(allocator.getStats().live == 0);
+}
+
+END_TEST
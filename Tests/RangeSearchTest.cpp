@@ -0,0 +1,129 @@
+#include "Tests.hpp"
+
+#include "../Game/Pathfinding.hpp"
+
+namespace
+{
+
+// On a map without walls, every cell in range is reached once, at its hexagonal distance
+bool matchesDistance(RangeSearch& search, const oe::Vector2i& start, U32 length, const oe::Vector2i& mapSize)
+{
+	std::vector<oe::Vector2i> reachables;
+	std::vector<U32> distances;
+	search.run(reachables, start, length, mapSize, &distances);
+	if (reachables.size() != distances.size())
+	{
+		return false;
+	}
+
+	oe::HexGrid<bool> reached;
+	reached.create(mapSize, false);
+	for (std::size_t i = 0; i < reachables.size(); i++)
+	{
+		if (!reached.contains(reachables[i]) || reached.testAndSet(reached.toIndex(reachables[i])))
+		{
+			return false;
+		}
+		if (distances[i] > length || (I32)distances[i] != AStar::distance(start, reachables[i]))
+		{
+			return false;
+		}
+	}
+
+	U32 inRange = 0;
+	for (I32 y = 0; y < mapSize.y; y++)
+	{
+		for (I32 x = 0; x < mapSize.x; x++)
+		{
+			if (AStar::distance(start, oe::Vector2i(x, y)) <= (I32)length)
+			{
+				inRange++;
+			}
+		}
+	}
+	return inRange == reachables.size();
+}
+
+} // namespace
+
+BEGIN_TEST(RangeSearch)
+
+RangeSearch search;
+
+TEST("Even row")
+{
+	const oe::Vector2i size(32, 32);
+	CHECK(matchesDistance(search, oe::Vector2i(16, 16), 1, size));
+	CHECK(matchesDistance(search, oe::Vector2i(16, 16), 2, size));
+	CHECK(matchesDistance(search, oe::Vector2i(16, 16), 7, size));
+	CHECK(matchesDistance(search, oe::Vector2i(3, 4), 6, size));
+	CHECK(matchesDistance(search, oe::Vector2i(0, 0), 5, size));
+}
+
+TEST("Odd row")
+{
+	const oe::Vector2i size(32, 32);
+	CHECK(matchesDistance(search, oe::Vector2i(16, 17), 1, size));
+	CHECK(matchesDistance(search, oe::Vector2i(16, 17), 2, size));
+	CHECK(matchesDistance(search, oe::Vector2i(16, 17), 7, size));
+	CHECK(matchesDistance(search, oe::Vector2i(31, 5), 6, size));
+	CHECK(matchesDistance(search, oe::Vector2i(31, 31), 5, size));
+}
+
+TEST("Length zero")
+{
+	std::vector<oe::Vector2i> reachables;
+	std::vector<U32> distances;
+	search.run(reachables, oe::Vector2i(4, 4), 0, oe::Vector2i(8, 8), &distances);
+	CHECK(reachables.empty());
+	CHECK(distances.empty());
+}
+
+TEST("Frontier capped by the map")
+{
+	// 15 cells : the ring buffer has 16 entries and every cell is pushed
+	const oe::Vector2i small(5, 3);
+	CHECK(matchesDistance(search, oe::Vector2i(2, 1), 10, small));
+	CHECK(matchesDistance(search, oe::Vector2i(0, 2), 10, small));
+	CHECK(search.getStats().visited == 15);
+
+	// 3 * 8 * 9 + 1 = 217 cells in range, 256 entries : the whole range fits, and only just
+	CHECK(matchesDistance(search, oe::Vector2i(20, 20), 8, oe::Vector2i(40, 40)));
+	CHECK(matchesDistance(search, oe::Vector2i(20, 21), 8, oe::Vector2i(40, 40)));
+
+	// The whole map is in range
+	CHECK(matchesDistance(search, oe::Vector2i(8, 9), 64, oe::Vector2i(16, 16)));
+
+	// Back to a smaller query on a bigger map, the buffer is reused
+	CHECK(matchesDistance(search, oe::Vector2i(30, 31), 3, oe::Vector2i(64, 64)));
+}
+
+TEST("Walls")
+{
+	CollisionMatrix map(16, 16);
+	for (I32 y = 0; y < 15; y++)
+	{
+		map.set(8, y, true);
+	}
+	map.set(4, 4, true);
+
+	std::vector<oe::Vector2i> reachables;
+	std::vector<U32> distances;
+	search.run(reachables, oe::Vector2i(4, 4), 20, map, &distances);
+	CHECK(!reachables.empty() && reachables[0] == oe::Vector2i(4, 4) && distances[0] == 0);
+
+	bool wallReached = false;
+	bool shorter = false;
+	bool behindWall = false;
+	for (std::size_t i = 1; i < reachables.size(); i++)
+	{
+		wallReached = wallReached || map.get(reachables[i]);
+		shorter = shorter || (I32)distances[i] < AStar::distance(oe::Vector2i(4, 4), reachables[i]);
+		behindWall = behindWall || reachables[i].x > 8;
+	}
+	CHECK(!wallReached);
+	CHECK(!shorter);
+	CHECK(behindWall);
+}
+
+END_TEST
@@ -0,0 +1,119 @@
+#include "Tests.hpp"
+
+#include "../Sources/System/StackAllocator.hpp"
+
+#include <cstdint>
+
+namespace
+{
+
+bool isAligned(const void* p, U32 alignment)
+{
+	return (reinterpret_cast<std::uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+} // namespace
+
+BEGIN_TEST(StackAllocator)
+
+TEST("Alignment")
+{
+	oe::StackAllocator<1024> stack;
+	void* a = stack.alloc(1, 1);
+	void* b = stack.alloc(8, 8);
+	void* c = stack.alloc(3, 16);
+	void* d = stack.alloc(5);
+	CHECK(a != nullptr && b != nullptr && c != nullptr && d != nullptr);
+	CHECK(isAligned(b, 8));
+	CHECK(isAligned(c, 16));
+	CHECK(isAligned(d, oe::StackAllocator<1024>::DefaultAlignment));
+	CHECK((U8*)b == (U8*)a + 8);
+	CHECK(stack.owns(a) && stack.owns(d));
+	U32 local = 0;
+	CHECK(!stack.owns(&local));
+}
+
+TEST("Full buffer")
+{
+	oe::StackAllocator<64> stack;
+	CHECK(stack.alloc(64, 1) != nullptr);
+	CHECK(stack.getRemainingSize() == 0);
+	CHECK(stack.alloc(1, 1) == nullptr);
+	CHECK(stack.getSize() == 64);
+	stack.clear();
+	CHECK(stack.getSize() == 0);
+	CHECK(stack.getMaxAllocation() == 64);
+	CHECK(stack.alloc(65, 1) == nullptr);
+	CHECK(stack.alloc(32, 1) != nullptr);
+	CHECK(stack.getMaxAllocation() == 64);
+}
+
+TEST("Typed allocations")
+{
+	oe::StackAllocator<256> stack;
+	U64* a = stack.alloc<U64>(5ULL);
+	U32* b = stack.alloc<U32>(6U);
+	CHECK(*a == 5 && *b == 6);
+	CHECK(isAligned(a, alignof(U64)));
+	CHECK(stack.getSize() == 12);
+	stack.free(b);
+	CHECK(stack.getSize() == 8);
+	CHECK(stack.alloc<U32>(7U) == b);
+}
+
+TEST("Double buffer")
+{
+	oe::DoubleBufferAllocator<256> buffer;
+	U32* a = buffer.alloc<U32>(1U);
+	buffer.swap();
+
+	// The frame before is still valid
+	U32* b = buffer.alloc<U32>(2U);
+	CHECK(*a == 1 && *b == 2);
+	CHECK(a != b);
+	CHECK(buffer.getFrameUsage() == sizeof(U32));
+	buffer.swap();
+
+	// The stack of a is used again
+	CHECK(*b == 2);
+	CHECK(buffer.alloc<U32>(3U) == a);
+	CHECK(buffer.getOverflowCount() == 0);
+}
+
+TEST("Overflow")
+{
+	oe::DoubleBufferAllocator<64> buffer;
+	void* a = buffer.alloc(48, 1);
+	void* b = buffer.alloc(32, 1);
+	CHECK(a != nullptr && b != nullptr);
+	std::memset(b, 0, 32);
+	CHECK(buffer.getOverflowCount() == 1);
+	buffer.swap();
+	CHECK(buffer.getFrameUsage() == 80);
+	CHECK(buffer.getPeakUsage() == 80);
+	buffer.alloc(16, 1);
+	buffer.swap();
+	CHECK(buffer.getFrameUsage() == 16);
+	CHECK(buffer.getPeakUsage() == 80);
+	CHECK(buffer.getOverflowCount() == 1);
+}
+
+TEST("Frame vector")
+{
+	oe::FrameAllocator* frame = new oe::FrameAllocator();
+	{
+		oe::FrameVector<U32> values;
+		for (U32 i = 0; i < 100; i++)
+		{
+			values.push_back(i);
+		}
+		CHECK(values.size() == 100);
+		CHECK(values[99] == 99);
+		CHECK(frame->getOverflowCount() == 0);
+	}
+	CHECK(oe::FrameAllocator::getSingletonPtr() == frame);
+	delete frame;
+	CHECK(oe::FrameAllocator::getSingletonPtr() == nullptr);
+}
+
+END_TEST
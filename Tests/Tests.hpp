@@ -0,0 +1,14 @@
+#ifndef TESTS_HPP
+#define TESTS_HPP
+
+#include "../Sources/System/UnitTest.hpp"
+
+// One function per test file, defined with BEGIN_TEST(name)
+void TestPoolAllocator();
+void TestStackAllocator();
+void TestList();
+void TestWorld();
+void TestRangeSearch();
+void TestHexGrid();
+
+#endif // TESTS_HPP
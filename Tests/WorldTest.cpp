@@ -0,0 +1,155 @@
+#include "Tests.hpp"
+
+#include "../Sources/Core/World.hpp"
+
+#include <set>
+
+BEGIN_TEST(World)
+
+oe::Application application(true);
+oe::World world(application);
+
+TEST("Handles")
+{
+	oe::EntityHandle handle = world.createEntity();
+	CHECK(handle.isValid());
+	CHECK(handle.get() != nullptr);
+	CHECK(handle.getGeneration() != 0);
+	CHECK(handle.get()->getHandle() == handle);
+	CHECK(world.getEntitiesCount() == 1);
+	world.update();
+	CHECK(world.getEntitiesPlaying() == 1);
+
+	oe::EntityHandle invalid;
+	CHECK(!invalid.isValid());
+	CHECK(invalid.get() == nullptr);
+	CHECK(invalid.getEntityId() == 0);
+
+	world.killEntity(handle);
+	CHECK(handle.isValid()); // Until the next update
+	world.update();
+	CHECK(!handle.isValid());
+	CHECK(world.getEntitiesCount() == 0);
+}
+
+TEST("Generation bump on reuse")
+{
+	oe::EntityHandle first = world.createEntity();
+	const U32 index = first.getHandleIndex();
+	const U32 generation = first.getGeneration();
+	world.killEntity(first);
+	world.update();
+
+	// The freed slot is used again, with the next generation
+	oe::EntityHandle second = world.createEntity();
+	CHECK(second.getHandleIndex() == index);
+	CHECK(second.getGeneration() == generation + 1);
+	CHECK(second != first);
+	CHECK(second.isValid());
+	world.killEntity(second);
+	world.update();
+}
+
+TEST("Stale handle rejected")
+{
+	oe::EntityHandle handle = world.createEntity();
+	const oe::EntityHandle stale(handle);
+	world.killEntity(handle);
+	world.update();
+	oe::EntityHandle reused = world.createEntity();
+	CHECK(reused.getHandleIndex() == stale.getHandleIndex());
+
+	// Same slot, another entity : the old handle finds nothing
+	CHECK(!stale.isValid());
+	CHECK(stale.get() == nullptr);
+	CHECK(stale.getAs<oe::Entity>() == nullptr);
+	CHECK(stale.getEntityId() == 0);
+	CHECK(reused.get() != nullptr);
+
+	// Killing through a stale handle does nothing
+	world.killEntity(stale);
+	world.update();
+	CHECK(reused.isValid());
+	world.killEntity(reused);
+	world.update();
+}
+
+TEST("Free list")
+{
+	oe::EntityHandle a = world.createEntity();
+	oe::EntityHandle b = world.createEntity();
+	oe::EntityHandle c = world.createEntity();
+	const U32 capacity = world.getSlotCapacity();
+	world.killEntity(a);
+	world.killEntity(c);
+	world.update();
+
+	std::set<U32> freed = { a.getHandleIndex(), c.getHandleIndex() };
+	oe::EntityHandle d = world.createEntity();
+	oe::EntityHandle e = world.createEntity();
+	CHECK(freed.count(d.getHandleIndex()) == 1);
+	CHECK(freed.count(e.getHandleIndex()) == 1);
+	CHECK(d.getHandleIndex() != e.getHandleIndex());
+	CHECK(world.getSlotCapacity() == capacity);
+	CHECK(b.isValid() && d.isValid() && e.isValid());
+	CHECK(!a.isValid() && !c.isValid());
+	world.killEntity(b);
+	world.killEntity(d);
+	world.killEntity(e);
+	world.update();
+}
+
+TEST("Chunks")
+{
+	// More entities than a chunk : the slots of the first chunk don't move
+	std::vector<oe::EntityHandle> handles;
+	std::vector<oe::Entity*> entities;
+	for (U32 i = 0; i < 1500; i++)
+	{
+		handles.push_back(world.createEntity());
+		entities.push_back(handles.back().get());
+	}
+	CHECK(world.getSlotCapacity() >= 1500);
+	std::set<U32> indices;
+	bool same = true;
+	for (U32 i = 0; i < handles.size(); i++)
+	{
+		indices.insert(handles[i].getHandleIndex());
+		same = same && handles[i].get() == entities[i];
+	}
+	CHECK(same);
+	CHECK(indices.size() == handles.size());
+	world.killEntities(handles.data(), handles.size());
+	world.update();
+	CHECK(world.getEntitiesCount() == 0);
+	bool invalid = true;
+	for (const oe::EntityHandle& handle : handles)
+	{
+		invalid = invalid && !handle.isValid();
+	}
+	CHECK(invalid);
+}
+
+TEST("System waves")
+{
+	oe::World systems(application);
+
+	// Timers, entities, then particles and animators together
+	CHECK(systems.getSystemWaveCount() == 3);
+
+	// After the particles, in a new wave
+	const U32 first = oe::World::Access::Game;
+	const U32 second = oe::World::Access::Game << 1;
+	systems.addSystem("First", oe::World::Access::Particles, first, [](oe::Time) {});
+	CHECK(systems.getSystemWaveCount() == 4);
+
+	// Disjoint from the first one : same wave
+	systems.addSystem("Second", oe::World::Access::Particles, second, [](oe::Time) {});
+	CHECK(systems.getSystemWaveCount() == 4);
+
+	// Reads what the first one writes : after it
+	systems.addSystem("Third", first, oe::World::Access::None, [](oe::Time) {});
+	CHECK(systems.getSystemWaveCount() == 5);
+}
+
+END_TEST
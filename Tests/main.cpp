@@ -0,0 +1,17 @@
+#include "Tests.hpp"
+
+// Unit tests of the engine and the game, they run without a window
+// Built like the game with Tests/*.cpp instead of Game/main.cpp : the other sources of Game/, Sources/ and the SFML libraries
+// The exit code is the number of failed checks
+
+int main()
+{
+	RUN_TEST(PoolAllocator)
+	RUN_TEST(StackAllocator)
+	RUN_TEST(List)
+	RUN_TEST(World)
+	RUN_TEST(RangeSearch)
+	RUN_TEST(HexGrid)
+
+	return (int)oe::UnitTest::getFailedChecks();
+}